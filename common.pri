@@ -0,0 +1,24 @@
+CONFIG += c++17
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+# 可执行文件统一输出到构建根目录的 release/debug 下
+CONFIG(debug, debug|release) {
+    BUILD_MODE = debug
+} else {
+    BUILD_MODE = release
+}
+BIN_DIR = $$shadowed($$PWD)/$$BUILD_MODE
+
+msvc {
+    # 指定编译器
+    QMAKE_CXXFLAGS += /std:c++17
+
+    # 生成 PDB 文件
+    QMAKE_CXXFLAGS_DEBUG += /Zi
+    QMAKE_CXXFLAGS_RELEASE += /Zi
+    QMAKE_LFLAGS_DEBUG += /DEBUG
+    QMAKE_LFLAGS_RELEASE += /DEBUG /OPT:REF /OPT:ICF
+}
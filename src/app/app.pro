@@ -0,0 +1,68 @@
+QT       += core gui network multimedia widgets
+
+TARGET = EasyNotify
+
+include(../../common.pri)
+include(../core/easynotifycore.pri)
+
+DESTDIR = $$BIN_DIR
+
+SOURCES += \
+    main.cpp \
+    ../core/providers/priorityiconprovider.cpp \
+    ../core/system/singleinstance.cpp \
+    ../models/active_remindertablemodel.cpp \
+    ../models/completed_remindertablemodel.cpp \
+    ../ui/windows/mainwindow.cpp \
+    ../ui/windows/activereminderwindow.cpp \
+    ../ui/windows/completedreminderwindow.cpp \
+    ../ui/widgets/active_reminderlist.cpp \
+    ../ui/widgets/completed_reminderlist.cpp \
+    ../ui/widgets/reminderliststyler.cpp \
+    ../ui/widgets/active_reminderedit.cpp \
+    ../ui/notifications/notificationPopup.cpp
+
+HEADERS += \
+    ../core/providers/priorityiconprovider.h \
+    ../core/system/singleinstance.h \
+    ../models/active_remindertablemodel.h \
+    ../models/completed_remindertablemodel.h \
+    ../models/remindercolumns.h \
+    ../ui/windows/mainwindow.h \
+    ../ui/windows/activereminderwindow.h \
+    ../ui/windows/completedreminderwindow.h \
+    ../ui/widgets/active_reminderlist.h \
+    ../ui/widgets/completed_reminderlist.h \
+    ../ui/widgets/reminderliststyler.h \
+    ../ui/widgets/active_reminderedit.h \
+    ../ui/notifications/notificationPopup.h
+
+FORMS += \
+    ../ui/windows/mainwindow.ui \
+    ../ui/widgets/active_reminderlist.ui \
+    ../ui/widgets/completed_reminderlist.ui \
+    ../ui/widgets/reminderedit.ui \
+    ../ui/notifications/notificationPopup.ui \
+    ../ui/windows/activereminderwindow.ui \
+    ../ui/windows/completedreminderwindow.ui
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
+
+# 资源文件
+RESOURCES += \
+    ../../resources.qrc
+
+# 指定 Qt 安装路径
+QTDIR = C:/Qt/6.8.2/msvc2022_64
+
+# 添加 dbghelp 库（崩溃转储，仅 Windows）
+win32: LIBS += -ldbghelp
+
+# 设置应用程序信息
+QMAKE_TARGET_COMPANY = "Your Company"
+QMAKE_TARGET_PRODUCT = "EasyNotify"
+QMAKE_TARGET_DESCRIPTION = "A simple reminder application"
+QMAKE_TARGET_COPYRIGHT = "Copyright (C) 2024"
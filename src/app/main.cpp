@@ -4,15 +4,18 @@
 #include <QApplication>
 #include <QDir>
 #include <QDateTime>
-#include <windows.h>
-#include <dbghelp.h>
 #include <QStandardPaths>
 #include <QCoreApplication>
 #include <QMessageBox>
-#include <psapi.h>
 #include <QFileInfo>
 #include <QFile>
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <dbghelp.h>
+#include <psapi.h>
+#endif
 
+#ifdef Q_OS_WIN
 // 设置崩溃转储文件的保存路径
 QString getDumpFilePath() {
 	QString dumpDir = QCoreApplication::applicationDirPath() + "/dumps";
@@ -141,6 +144,7 @@ LONG WINAPI TopLevelExceptionHandler(EXCEPTION_POINTERS* pExceptionInfo) {
 
 	return EXCEPTION_CONTINUE_SEARCH;
 }
+#endif // Q_OS_WIN
 
 bool checkWavFormat(const QString &filePath) {
     QFile file(filePath);
@@ -183,8 +187,10 @@ bool checkWavFormat(const QString &filePath) {
 
 int main(int argc, char *argv[])
 {
+#ifdef Q_OS_WIN
 	// 设置异常处理
 	SetUnhandledExceptionFilter(TopLevelExceptionHandler);
+#endif
 
 	QApplication a(argc, argv);
 	a.setQuitOnLastWindowClosed(false);
@@ -5,6 +5,7 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QRegularExpression>
+#include <algorithm>
 #include "core/logging/logger.h"
 
 namespace {
@@ -13,6 +14,17 @@ QString localCalendarPath()
 {
     return QCoreApplication::applicationDirPath() + "/workdays.json";
 }
+
+bool isWeekend(const QDate &date)
+{
+    return date.dayOfWeek() > Qt::Friday;
+}
+
+// 儒略日小于 jd 的所有日期中周一至周五的天数（儒略日 0 为周一）
+qint64 weekdaysBefore(qint64 jd)
+{
+    return (jd / 7) * 5 + qMin<qint64>(jd % 7, 5);
+}
 }
 
 WorkdayCalendar &WorkdayCalendar::instance()
@@ -23,6 +35,8 @@ WorkdayCalendar &WorkdayCalendar::instance()
 
 WorkdayCalendar::WorkdayCalendar()
 {
+    // 内置工作日数据编译在静态核心库中，需要显式注册
+    Q_INIT_RESOURCE(easynotifycore);
     loadCalendar();
 }
 
@@ -72,6 +86,43 @@ QDate WorkdayCalendar::nextWorkday(const QDate &fromDate, bool includeCurrentDay
     return QDate();
 }
 
+int WorkdayCalendar::workdaysBetween(const QDate &from, const QDate &to) const
+{
+    if (!from.isValid() || !to.isValid() || from > to) {
+        return 0;
+    }
+    const qint64 weekdays = weekdaysBefore(to.toJulianDay() + 1) - weekdaysBefore(from.toJulianDay());
+    return static_cast<int>(weekdays
+                            - countInRange(m_weekdayHolidays, from, to)
+                            + countInRange(m_weekendMakeups, from, to));
+}
+
+int WorkdayCalendar::countInRange(const QVector<QDate> &sorted, const QDate &from, const QDate &to)
+{
+    const auto first = std::lower_bound(sorted.cbegin(), sorted.cend(), from);
+    const auto last = std::upper_bound(first, sorted.cend(), to);
+    return static_cast<int>(last - first);
+}
+
+void WorkdayCalendar::rebuildSortedExceptions()
+{
+    m_weekdayHolidays.clear();
+    m_weekendMakeups.clear();
+    for (const QDate &date : std::as_const(m_holidays)) {
+        // 同时标记为调休的日期按工作日处理，不算例外
+        if (!isWeekend(date) && !m_makeupWorkdays.contains(date)) {
+            m_weekdayHolidays.append(date);
+        }
+    }
+    for (const QDate &date : std::as_const(m_makeupWorkdays)) {
+        if (isWeekend(date)) {
+            m_weekendMakeups.append(date);
+        }
+    }
+    std::sort(m_weekdayHolidays.begin(), m_weekdayHolidays.end());
+    std::sort(m_weekendMakeups.begin(), m_weekendMakeups.end());
+}
+
 void WorkdayCalendar::loadCalendar()
 {
     const QString localPath = localCalendarPath();
@@ -179,6 +230,7 @@ bool WorkdayCalendar::parseDocument(const QJsonDocument &doc)
 
     m_holidays = holidaysSet;
     m_makeupWorkdays = makeupSet;
+    rebuildSortedExceptions();
     LOG_INFO(QString("工作日配置：节假日 %1 天，调休 %2 天")
                  .arg(m_holidays.size())
                  .arg(m_makeupWorkdays.size()));
@@ -3,6 +3,7 @@
 
 #include <QDate>
 #include <QSet>
+#include <QVector>
 
 class QJsonDocument;
 
@@ -15,6 +16,8 @@ public:
     bool isMakeupWorkday(const QDate &date) const;
     bool isWorkday(const QDate &date) const;
     QDate nextWorkday(const QDate &fromDate, bool includeCurrentDay = false) const;
+    // [from, to] 闭区间内的工作日天数，O(log n)（n 为节假日/调休条目数）
+    int workdaysBetween(const QDate &from, const QDate &to) const;
 
 private:
     WorkdayCalendar();
@@ -24,9 +27,14 @@ private:
     bool loadFromResource(const QString &resourcePath);
     bool parseDocument(const QJsonDocument &doc);
     static QDate parseDate(const QString &text);
+    void rebuildSortedExceptions();
+    static int countInRange(const QVector<QDate> &sorted, const QDate &from, const QDate &to);
 
     QSet<QDate> m_holidays;
     QSet<QDate> m_makeupWorkdays;
+    // 有序的"例外日"：落在周一至周五的节假日、落在周末的调休日，供区间计数二分查找
+    QVector<QDate> m_weekdayHolidays;
+    QVector<QDate> m_weekendMakeups;
 };
 
 #endif // WORKDAYCALENDAR_H
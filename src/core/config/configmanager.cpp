@@ -4,13 +4,70 @@
 #include <QSet>
 #include <QSqlQuery>
 #include <QSqlError>
-#include <QJsonObject>
 #include <QDir>
+#include <QThread>
+#include <utility>
+#include "core/reminders/reminderrowcodec.h"
 
 const QString ConfigManager::CONFIG_DB = "config.db";
+const QString ConfigManager::CONNECTION_NAME = "config_connection";
 const QString ConfigManager::PAUSED_KEY = "isPaused";
 const QString ConfigManager::AUTO_START_KEY = "autoStart";
 const QString ConfigManager::SOUND_ENABLED_KEY = "soundEnabled";
+const QString ConfigManager::SCHEDULER_BACKEND_KEY = "schedulerBackend";
+const QString ConfigManager::JOURNAL_MAX_DELAY_KEY = "journalMaxDelayMs";
+const QString ConfigManager::CATCH_UP_POLICY_KEY = "catchUpPolicy";
+const QString ConfigManager::SCHEDULER_HORIZON_KEY = "schedulerHorizonHours";
+const QString ConfigManager::DB_PROFILE_KEY = "dbProfile";
+const QString ConfigManager::MAX_POPUPS_KEY = "maxPopups";
+QString ConfigManager::databasePathOverride;
+
+namespace {
+struct DbProfile {
+    const char *name;
+    const char *journalMode;
+    const char *synchronous;
+    qint64 mmapSize;     // 字节，0 表示不使用内存映射
+    int cacheSizeKiB;
+};
+
+// durable：WAL + FULL，每次提交都等待落盘；
+// balanced：WAL + NORMAL，进程崩溃不丢数据，断电可能丢失最后几次提交（默认）；
+// fast：WAL + OFF，只适合可重建的数据与基准测试；
+// legacy：SQLite 默认的回滚日志模式，用于对照
+const DbProfile kDbProfiles[] = {
+    {"durable", "WAL", "FULL", 0, 2048},
+    {"balanced", "WAL", "NORMAL", 64ll * 1024 * 1024, 8192},
+    {"fast", "WAL", "OFF", 256ll * 1024 * 1024, 32768},
+    {"legacy", "DELETE", "FULL", 0, 2048},
+};
+constexpr int kDefaultDbProfile = 1;
+
+// 1：reminders 表，next_trigger 为本地时间 ISO 文本，无二级索引（user_version 为 0 的旧库）；
+// 2：reminders_v2 表，next_trigger 为 UTC 纪元分钟整数，带 (completed, next_trigger) 索引
+constexpr int kSchemaVersion = 2;
+
+int profileIndex(const QString &name)
+{
+    const QString key = name.trimmed().toLower();
+    for (int i = 0; i < int(sizeof(kDbProfiles) / sizeof(kDbProfiles[0])); ++i) {
+        if (key == QLatin1String(kDbProfiles[i].name)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// settings.value 是 TEXT 列，读回的总是文本；缓存与待写集合统一存成同样的文本
+// （布尔值为 "1"/"0"），比较是否变化时才不会因 QVariant 类型不同而误判
+QVariant normalizedSetting(const QVariant &value)
+{
+    if (value.typeId() == QMetaType::Bool) {
+        return QString(value.toBool() ? QStringLiteral("1") : QStringLiteral("0"));
+    }
+    return value.toString();
+}
+}
 
 ConfigManager& ConfigManager::instance()
 {
@@ -18,15 +75,37 @@ ConfigManager& ConfigManager::instance()
     return instance;
 }
 
+void ConfigManager::setDatabasePath(const QString &path)
+{
+    databasePathOverride = path;
+}
+
 ConfigManager::ConfigManager(QObject *parent)
     : QObject(parent)
+    , m_profile(kDefaultDbProfile)
+    , m_legacyPending(false)
+    , m_settingsFlushScheduled(false)
+    , m_settingsFailuresDropped(false)
+    , m_settingsRetryMs(0)
+    , m_settingsFlushFailures(0)
+    , m_settingsFlushWaiters(0)
 {
+    m_settingsWriter.setMaxThreadCount(1);
     init();
 }
 
 ConfigManager::~ConfigManager()
 {
     LOG_INFO("ConfigManager 析构函数被调用");
+    // 后台排队的设置写入先落盘，再关闭连接
+    flushSettings();
+    if (m_statements.hasLocalData()) {
+        m_statements.localData()->statements.clear();
+        m_statements.localData()->invalid.reset();
+    }
+    if (db.isOpen()) {
+        db.close();
+    }
 }
 
 void ConfigManager::init()
@@ -38,20 +117,33 @@ void ConfigManager::init()
     }
     ensureTables();
     loadConfig();
+    // 档位保存在 settings 表中，只能在打开数据库之后读取并应用
+    const QString profile = readSetting(DB_PROFILE_KEY, QLatin1String(kDbProfiles[kDefaultDbProfile].name)).toString();
+    const int index = profileIndex(profile);
+    if (index < 0) {
+        LOG_WARNING(QString("未知的数据库档位: %1，使用 %2").arg(profile, QLatin1String(kDbProfiles[kDefaultDbProfile].name)));
+    }
+    m_profile = index < 0 ? kDefaultDbProfile : index;
+    applyProfile(db);
 }
 
 QString ConfigManager::getConfigPath() const
 {
-    QString path = QCoreApplication::applicationDirPath() + "/" + CONFIG_DB;
+    QString path = databasePathOverride.isEmpty()
+        ? QCoreApplication::applicationDirPath() + "/" + CONFIG_DB
+        : databasePathOverride;
     LOG_INFO(QString("获取配置文件路径: %1").arg(path));
     return path;
 }
 
+QString ConfigManager::databasePath() const
+{
+    return getConfigPath();
+}
+
 bool ConfigManager::isPaused() const
 {
-    bool paused = readSetting(PAUSED_KEY, false).toBool();
-    LOG_INFO(QString("获取暂停状态: %1").arg(paused));
-    return paused;
+    return readSetting(PAUSED_KEY, false).toBool();
 }
 
 void ConfigManager::setPaused(bool paused)
@@ -62,16 +154,12 @@ void ConfigManager::setPaused(bool paused)
 
 bool ConfigManager::isAutoStart() const
 {
-    bool autoStart = readSetting(AUTO_START_KEY, false).toBool();
-    LOG_INFO(QString("获取开机启动状态: %1").arg(autoStart));
-    return autoStart;
+    return readSetting(AUTO_START_KEY, false).toBool();
 }
 
 bool ConfigManager::isSoundEnabled() const
 {
-    bool enabled = readSetting(SOUND_ENABLED_KEY, true).toBool();
-    LOG_INFO(QString("获取声音提醒状态: %1").arg(enabled));
-    return enabled;
+    return readSetting(SOUND_ENABLED_KEY, true).toBool();
 }
 
 void ConfigManager::setAutoStart(bool autoStart)
@@ -95,31 +183,268 @@ void ConfigManager::setSoundEnabled(bool enabled)
     writeSetting(SOUND_ENABLED_KEY, enabled);
 }
 
-QJsonArray ConfigManager::getReminders() const
+QString ConfigManager::schedulerBackend() const
+{
+    return readSetting(SCHEDULER_BACKEND_KEY, QStringLiteral("heap")).toString();
+}
+
+void ConfigManager::setSchedulerBackend(const QString &backend)
+{
+    LOG_INFO(QString("设置调度队列实现: %1").arg(backend));
+    writeSetting(SCHEDULER_BACKEND_KEY, backend);
+}
+
+int ConfigManager::journalMaxDelay() const
+{
+    return readSetting(JOURNAL_MAX_DELAY_KEY, 50).toInt();
+}
+
+void ConfigManager::setJournalMaxDelay(int ms)
+{
+    LOG_INFO(QString("设置写后日志最大延迟: %1 ms").arg(ms));
+    writeSetting(JOURNAL_MAX_DELAY_KEY, ms);
+}
+
+int ConfigManager::schedulerHorizonHours() const
 {
-    QJsonArray reminders = readRemindersFromDb();
+    return qMax(0, readSetting(SCHEDULER_HORIZON_KEY, 0).toInt());
+}
+
+void ConfigManager::setSchedulerHorizonHours(int hours)
+{
+    LOG_INFO(QString("设置调度近期窗口: %1 小时").arg(hours));
+    writeSetting(SCHEDULER_HORIZON_KEY, qMax(0, hours));
+}
+
+int ConfigManager::maxPopups() const
+{
+    return qMax(0, readSetting(MAX_POPUPS_KEY, 0).toInt());
+}
+
+void ConfigManager::setMaxPopups(int count)
+{
+    LOG_INFO(QString("设置同时弹窗上限: %1").arg(count));
+    writeSetting(MAX_POPUPS_KEY, qMax(0, count));
+}
+
+QString ConfigManager::catchUpPolicy() const
+{
+    return readSetting(CATCH_UP_POLICY_KEY, QStringLiteral("once")).toString();
+}
+
+void ConfigManager::setCatchUpPolicy(const QString &policy)
+{
+    LOG_INFO(QString("设置错过提醒补发策略: %1").arg(policy));
+    writeSetting(CATCH_UP_POLICY_KEY, policy);
+}
+
+QString ConfigManager::dbProfile() const
+{
+    return QLatin1String(kDbProfiles[m_profile.load()].name);
+}
+
+void ConfigManager::setDbProfile(const QString &profile)
+{
+    const int index = profileIndex(profile);
+    if (index < 0) {
+        LOG_WARNING(QString("未知的数据库档位: %1，保持 %2").arg(profile, dbProfile()));
+        return;
+    }
+    LOG_INFO(QString("设置数据库档位: %1").arg(QLatin1String(kDbProfiles[index].name)));
+    m_profile = index;
+    QSqlDatabase conn = database();
+    applyProfile(conn);
+    writeSetting(DB_PROFILE_KEY, QLatin1String(kDbProfiles[index].name));
+}
+
+QStringList ConfigManager::dbProfiles()
+{
+    QStringList names;
+    for (const DbProfile &profile : kDbProfiles) {
+        names.append(QLatin1String(profile.name));
+    }
+    return names;
+}
+
+void ConfigManager::applyProfile(QSqlDatabase &conn) const
+{
+    const DbProfile &profile = kDbProfiles[m_profile.load()];
+    // PRAGMA 不能绑定参数，且 journal_mode 等只对当前连接生效（WAL 会写入文件头），逐个连接执行
+    QSqlQuery pragma(conn);
+    if (pragma.exec(QString("PRAGMA journal_mode=%1").arg(profile.journalMode)) && pragma.next()) {
+        const QString mode = pragma.value(0).toString();
+        if (mode.compare(QLatin1String(profile.journalMode), Qt::CaseInsensitive) != 0) {
+            LOG_WARNING(QString("切换日志模式失败，当前为 %1（其他连接仍在使用时无法退出 WAL）").arg(mode));
+        }
+    }
+    pragma.finish();
+    const QStringList statements = {
+        QString("PRAGMA synchronous=%1").arg(profile.synchronous),
+        QString("PRAGMA mmap_size=%1").arg(profile.mmapSize),
+        // 负值表示以 KiB 为单位
+        QString("PRAGMA cache_size=-%1").arg(profile.cacheSizeKiB),
+    };
+    for (const QString &sql : statements) {
+        if (!pragma.exec(sql)) {
+            LOG_ERROR(QString("设置数据库参数失败 [%1]: %2").arg(sql, pragma.lastError().text()));
+        }
+        pragma.finish();
+    }
+    LOG_INFO(QString("连接 %1 使用数据库档位: %2").arg(conn.connectionName(), QLatin1String(profile.name)));
+}
+
+QSqlQuery &ConfigManager::statement(const QString &sql) const
+{
+    if (!m_statements.hasLocalData()) {
+        m_statements.setLocalData(new StatementCache);
+    }
+    StatementCache *cache = m_statements.localData();
+    auto it = cache->statements.constFind(sql);
+    if (it != cache->statements.constEnd()) {
+        return *it.value();
+    }
+    auto query = std::make_shared<QSqlQuery>(database());
+    // 所有缓存语句都只向前遍历结果，不需要驱动缓存已读过的行
+    query->setForwardOnly(true);
+    if (!query->prepare(sql)) {
+        // 准备失败（如表尚未创建）不缓存，下次重新 prepare
+        LOG_ERROR(QString("预编译语句失败 [%1]: %2").arg(sql, query->lastError().text()));
+        cache->invalid = query;
+        return *query;
+    }
+    cache->statements.insert(sql, query);
+    return *query;
+}
+
+QVector<Reminder> ConfigManager::getReminders() const
+{
+    QVector<Reminder> reminders = readRemindersFromDb();
     LOG_INFO(QString("获取提醒列表，共 %1 个提醒").arg(reminders.size()));
     return reminders;
 }
 
-void ConfigManager::setReminders(const QJsonArray &reminders)
+void ConfigManager::setReminders(const QVector<Reminder> &reminders)
 {
-    QJsonArray unique = reminders;
+    QVector<Reminder> unique = reminders;
     deduplicate(unique);
     LOG_INFO(QString("设置提醒列表，共 %1 个提醒").arg(unique.size()));
     writeRemindersToDb(unique);
 }
 
+bool ConfigManager::applyReminderChanges(const QVector<Reminder> &upserts, const QStringList &deletedIds)
+{
+    if (upserts.isEmpty() && deletedIds.isEmpty()) {
+        return true;
+    }
+    LOG_INFO(QString("增量保存提醒：更新 %1 个，删除 %2 个").arg(upserts.size()).arg(deletedIds.size()));
+
+    QSqlDatabase conn = database();
+    if (!conn.transaction()) {
+        LOG_ERROR(QString("开启事务失败: %1").arg(conn.lastError().text()));
+        return false;
+    }
+
+    bool ok = true;
+    QSqlQuery &upsert = statement(QString("INSERT INTO reminders_v2 (%1) VALUES (?, ?, ?, ?, ?, ?) "
+                                          "ON CONFLICT(id) DO UPDATE SET "
+                                          "name = excluded.name, type = excluded.type, priority = excluded.priority, "
+                                          "next_trigger = excluded.next_trigger, completed = excluded.completed")
+                                      .arg(ReminderRowCodec::columns()));
+    for (const Reminder &reminder : upserts) {
+        ReminderRowCodec::bind(upsert, reminder);
+        if (!upsert.exec()) {
+            LOG_ERROR(QString("写入提醒失败 (ID=%1): %2")
+                      .arg(reminder.id(), upsert.lastError().text()));
+            ok = false;
+            break;
+        }
+    }
+
+    if (ok && !deletedIds.isEmpty()) {
+        QSqlQuery &remove = statement(QStringLiteral("DELETE FROM reminders_v2 WHERE id = ?"));
+        for (const QString &id : deletedIds) {
+            remove.addBindValue(id);
+            if (!remove.exec()) {
+                LOG_ERROR(QString("删除提醒失败 (ID=%1): %2").arg(id, remove.lastError().text()));
+                ok = false;
+                break;
+            }
+        }
+    }
+    // 尚未迁移的旧行也要删掉，否则迁移时会被搬回来
+    if (ok && !deletedIds.isEmpty() && m_legacyPending.load()) {
+        QSqlQuery remove(conn);
+        remove.prepare(QStringLiteral("DELETE FROM reminders WHERE id = ?"));
+        for (const QString &id : deletedIds) {
+            remove.addBindValue(id);
+            if (!remove.exec()) {
+                LOG_ERROR(QString("删除旧表提醒失败 (ID=%1): %2").arg(id, remove.lastError().text()));
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    if (!ok) {
+        conn.rollback();
+        return false;
+    }
+    if (!conn.commit()) {
+        LOG_ERROR(QString("提交事务失败: %1").arg(conn.lastError().text()));
+        conn.rollback();
+        return false;
+    }
+    return true;
+}
+
+QVector<Reminder> ConfigManager::getRemindersDueBetween(qint64 fromMinute, qint64 toMinute) const
+{
+    QVector<Reminder> reminders;
+    QSqlQuery &query = statement(QString("SELECT %1 FROM reminders_v2 "
+                                         "WHERE completed = 0 AND next_trigger >= ? AND next_trigger < ?")
+                                     .arg(ReminderRowCodec::columns()));
+    query.addBindValue(static_cast<qlonglong>(fromMinute));
+    query.addBindValue(static_cast<qlonglong>(toMinute));
+    if (query.exec()) {
+        while (query.next()) {
+            reminders.append(ReminderRowCodec::read(query));
+        }
+    } else {
+        LOG_ERROR(QString("按时间范围读取提醒失败: %1").arg(query.lastError().text()));
+    }
+    query.finish();
+    return reminders;
+}
+
+QSet<QString> ConfigManager::existingReminderIds(const QStringList &ids) const
+{
+    QSet<QString> existing;
+    QSqlQuery &query = statement(QStringLiteral("SELECT 1 FROM reminders_v2 WHERE id = ?"));
+    for (const QString &id : ids) {
+        query.addBindValue(id);
+        if (!query.exec()) {
+            LOG_ERROR(QString("查询提醒是否存在失败: %1").arg(query.lastError().text()));
+            break;
+        }
+        if (query.next()) {
+            existing.insert(id);
+        }
+        query.finish();
+    }
+    query.finish();
+    return existing;
+}
+
 void ConfigManager::loadConfig()
 {
+    loadSettings();
     // 如果数据库没有任何设置，填充默认值
-    QSqlQuery query(db);
-    query.exec(QStringLiteral("SELECT COUNT(*) FROM settings"));
-    int count = 0;
-    if (query.next()) {
-        count = query.value(0).toInt();
+    bool empty = false;
+    {
+        QReadLocker locker(&m_settingsLock);
+        empty = m_settings.isEmpty();
     }
-    if (count == 0) {
+    if (empty) {
         LOG_INFO("设置表为空，写入默认配置");
         initDefaultConfig();
     }
@@ -131,32 +456,36 @@ void ConfigManager::initDefaultConfig()
     writeSetting(PAUSED_KEY, false);
     writeSetting(AUTO_START_KEY, false);
     writeSetting(SOUND_ENABLED_KEY, true);
-    writeRemindersToDb(QJsonArray());
+    writeRemindersToDb(QVector<Reminder>());
 }
 
-void ConfigManager::deduplicate(QJsonArray &reminders)
+void ConfigManager::deduplicate(QVector<Reminder> &reminders)
 {
-    QSet<QString> ids;
-    QJsonArray unique;
-    for (const QJsonValue &val : reminders) {
-        if (!val.isObject())
-            continue;
-        QJsonObject obj = val.toObject();
-        QString id = obj.value("id").toString();
-        if (ids.contains(id)) {
-            LOG_WARNING(QString("发现重复的提醒 ID: %1，已移除").arg(id));
+    // 原地压缩，没有重复时不产生任何复制
+    QSet<ReminderId> ids;
+    ids.reserve(reminders.size());
+    int kept = 0;
+    for (int i = 0; i < reminders.size(); ++i) {
+        const Reminder &reminder = reminders.at(i);
+        if (ids.contains(reminder.key())) {
+            LOG_WARNING(QString("发现重复的提醒 ID: %1，已移除").arg(reminder.id()));
             continue;
         }
-        ids.insert(id);
-        unique.append(obj);
+        ids.insert(reminder.key());
+        if (kept != i) {
+            reminders[kept] = reminder;
+        }
+        ++kept;
     }
-    reminders = unique;
+    reminders.resize(kept);
 }
 
 bool ConfigManager::openDatabase()
 {
-    db = QSqlDatabase::addDatabase("QSQLITE", "config_connection");
+    db = QSqlDatabase::addDatabase("QSQLITE", CONNECTION_NAME);
     db.setDatabaseName(getConfigPath());
+    // 多个线程各自持有连接，写冲突时等待而不是立即失败
+    db.setConnectOptions(QStringLiteral("QSQLITE_BUSY_TIMEOUT=5000"));
     if (!db.open()) {
         LOG_ERROR(QString("打开配置数据库失败: %1").arg(db.lastError().text()));
         return false;
@@ -164,6 +493,54 @@ bool ConfigManager::openDatabase()
     return true;
 }
 
+QString ConfigManager::connectionName() const
+{
+    if (QThread::currentThread() == thread()) {
+        return CONNECTION_NAME;
+    }
+    return QString("%1_%2").arg(CONNECTION_NAME)
+        .arg(reinterpret_cast<quintptr>(QThread::currentThread()));
+}
+
+QSqlDatabase ConfigManager::database() const
+{
+    // QSqlDatabase 连接不能跨线程使用，其他线程首次访问时按连接名克隆一份（按名克隆不会读取主线程的连接对象）
+    const QString name = connectionName();
+    if (name == CONNECTION_NAME) {
+        return db;
+    }
+    if (QSqlDatabase::contains(name)) {
+        return QSqlDatabase::database(name);
+    }
+    QSqlDatabase threadDb = QSqlDatabase::cloneDatabase(CONNECTION_NAME, name);
+    if (!threadDb.open()) {
+        LOG_ERROR(QString("打开线程数据库连接失败: %1").arg(threadDb.lastError().text()));
+    } else {
+        LOG_INFO(QString("已为线程创建数据库连接: %1").arg(name));
+        applyProfile(threadDb);
+    }
+    return threadDb;
+}
+
+void ConfigManager::releaseThreadConnection()
+{
+    const QString name = connectionName();
+    if (name == CONNECTION_NAME || !QSqlDatabase::contains(name)) {
+        return;
+    }
+    // 缓存的语句仍引用该连接，必须先于连接释放
+    if (m_statements.hasLocalData()) {
+        m_statements.localData()->statements.clear();
+        m_statements.localData()->invalid.reset();
+    }
+    {
+        QSqlDatabase threadDb = QSqlDatabase::database(name, false);
+        threadDb.close();
+    }
+    QSqlDatabase::removeDatabase(name);
+    LOG_INFO(QString("已释放线程数据库连接: %1").arg(name));
+}
+
 void ConfigManager::ensureTables()
 {
     QSqlQuery query(db);
@@ -172,86 +549,323 @@ void ConfigManager::ensureTables()
                                    "value TEXT)"))) {
         LOG_ERROR(QString("创建 settings 表失败: %1").arg(query.lastError().text()));
     }
-    if (!query.exec(QStringLiteral("CREATE TABLE IF NOT EXISTS reminders ("
+    if (!query.exec(QStringLiteral("CREATE TABLE IF NOT EXISTS reminders_v2 ("
                                    "id TEXT PRIMARY KEY,"
                                    "name TEXT,"
-                                   "type INTEGER,"
-                                   "priority INTEGER,"
-                                   "next_trigger TEXT,"
-                                   "completed INTEGER)"))) {
-        LOG_ERROR(QString("创建 reminders 表失败: %1").arg(query.lastError().text()));
+                                   "type INTEGER NOT NULL,"
+                                   "priority INTEGER NOT NULL,"
+                                   "next_trigger INTEGER,"
+                                   "completed INTEGER NOT NULL)"))) {
+        LOG_ERROR(QString("创建 reminders_v2 表失败: %1").arg(query.lastError().text()));
+    }
+    // "下一个到期" 与 "已完成列表" 都按该索引做范围查询，不再全表扫描
+    if (!query.exec(QStringLiteral("CREATE INDEX IF NOT EXISTS reminders_v2_due "
+                                   "ON reminders_v2 (completed, next_trigger)"))) {
+        LOG_ERROR(QString("创建 reminders_v2 索引失败: %1").arg(query.lastError().text()));
+    }
+
+    int version = 0;
+    if (query.exec(QStringLiteral("PRAGMA user_version")) && query.next()) {
+        version = query.value(0).toInt();
+    }
+    bool legacyTable = false;
+    if (query.exec(QStringLiteral("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'reminders'"))) {
+        legacyTable = query.next();
+    }
+    query.finish();
+
+    if (legacyTable) {
+        // 旧表可能已在上次运行中迁移了一部分，剩余的行继续在后台搬移
+        LOG_INFO(QString("检测到版本 %1 的提醒表，将在后台迁移到版本 %2").arg(qMax(version, 1)).arg(kSchemaVersion));
+        m_legacyPending = true;
+    } else if (version != kSchemaVersion) {
+        if (!query.exec(QString("PRAGMA user_version = %1").arg(kSchemaVersion))) {
+            LOG_ERROR(QString("写入表结构版本失败: %1").arg(query.lastError().text()));
+        }
     }
 }
 
-QVariant ConfigManager::readSetting(const QString &key, const QVariant &defaultValue) const
+bool ConfigManager::legacyMigrationPending() const
 {
-    QSqlQuery query(db);
-    query.prepare(QStringLiteral("SELECT value FROM settings WHERE key = ?"));
-    query.addBindValue(key);
-    if (query.exec() && query.next()) {
-        return query.value(0);
+    return m_legacyPending.load();
+}
+
+int ConfigManager::migrateLegacyBatch(int batchSize)
+{
+    if (!m_legacyPending.load()) {
+        return 0;
+    }
+    QSqlDatabase conn = database();
+    if (!conn.transaction()) {
+        LOG_ERROR(QString("开启事务失败: %1").arg(conn.lastError().text()));
+        return -1;
     }
-    return defaultValue;
+
+    // 旧表只在迁移期间存在，不进入语句缓存
+    QSqlQuery select(conn);
+    select.setForwardOnly(true);
+    select.prepare(QString("SELECT %1 FROM reminders LIMIT ?").arg(ReminderRowCodec::columns()));
+    select.addBindValue(qMax(1, batchSize));
+    if (!select.exec()) {
+        LOG_ERROR(QString("读取旧提醒表失败: %1").arg(select.lastError().text()));
+        conn.rollback();
+        return -1;
+    }
+    QVector<Reminder> batch;
+    while (select.next()) {
+        batch.append(ReminderRowCodec::readLegacy(select));
+    }
+    select.finish();
+
+    bool ok = true;
+    if (batch.isEmpty()) {
+        QSqlQuery finish(conn);
+        ok = finish.exec(QStringLiteral("DROP TABLE reminders"))
+            && finish.exec(QString("PRAGMA user_version = %1").arg(kSchemaVersion));
+        if (!ok) {
+            LOG_ERROR(QString("结束提醒表迁移失败: %1").arg(finish.lastError().text()));
+        }
+    } else {
+        // 新表中已有的行是迁移开始后写入的，比旧表新，保留不动
+        QSqlQuery insert(conn);
+        insert.prepare(QString("INSERT OR IGNORE INTO reminders_v2 (%1) VALUES (?, ?, ?, ?, ?, ?)")
+                           .arg(ReminderRowCodec::columns()));
+        QSqlQuery remove(conn);
+        remove.prepare(QStringLiteral("DELETE FROM reminders WHERE id = ?"));
+        for (const Reminder &reminder : std::as_const(batch)) {
+            ReminderRowCodec::bind(insert, reminder);
+            remove.addBindValue(reminder.id());
+            if (!insert.exec() || !remove.exec()) {
+                LOG_ERROR(QString("迁移提醒失败 (ID=%1): %2 %3")
+                          .arg(reminder.id(), insert.lastError().text(), remove.lastError().text()));
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    if (!ok) {
+        conn.rollback();
+        return -1;
+    }
+    if (!conn.commit()) {
+        LOG_ERROR(QString("提交事务失败: %1").arg(conn.lastError().text()));
+        conn.rollback();
+        return -1;
+    }
+    if (batch.isEmpty()) {
+        m_legacyPending = false;
+        LOG_INFO(QString("提醒表迁移完成，表结构版本 %1").arg(kSchemaVersion));
+    }
+    return batch.size();
 }
 
-void ConfigManager::writeSetting(const QString &key, const QVariant &value)
+void ConfigManager::loadSettings()
 {
     QSqlQuery query(db);
-    query.prepare(QStringLiteral("REPLACE INTO settings (key, value) VALUES (?, ?)"));
-    query.addBindValue(key);
-    query.addBindValue(value);
-    if (!query.exec()) {
-        LOG_ERROR(QString("写入设置失败 [%1]: %2").arg(key, query.lastError().text()));
+    query.setForwardOnly(true);
+    if (!query.exec(QStringLiteral("SELECT key, value FROM settings"))) {
+        LOG_ERROR(QString("读取设置失败: %1").arg(query.lastError().text()));
+        return;
     }
+    QWriteLocker locker(&m_settingsLock);
+    while (query.next()) {
+        m_settings.insert(query.value(0).toString(), normalizedSetting(query.value(1)));
+    }
+    LOG_INFO(QString("已加载 %1 项设置").arg(m_settings.size()));
 }
 
-QJsonArray ConfigManager::readRemindersFromDb() const
+QVariant ConfigManager::readSetting(const QString &key, const QVariant &defaultValue) const
 {
-    QJsonArray array;
-    QSqlQuery query(db);
-    if (query.exec(QStringLiteral("SELECT id, name, type, priority, next_trigger, completed FROM reminders"))) {
+    QReadLocker locker(&m_settingsLock);
+    return m_settings.value(key, defaultValue);
+}
+
+void ConfigManager::writeSetting(const QString &key, const QVariant &rawValue)
+{
+    const QVariant value = normalizedSetting(rawValue);
+    {
+        QWriteLocker locker(&m_settingsLock);
+        auto it = m_settings.find(key);
+        if (it != m_settings.end() && it.value() == value) {
+            return;
+        }
+        m_settings.insert(key, value);
+    }
+    {
+        QMutexLocker locker(&m_pendingMutex);
+        m_pendingSettings.insert(key, value);
+        if (!m_settingsFlushScheduled) {
+            m_settingsFlushScheduled = true;
+            m_settingsWriter.start([this]() { writePendingSettings(); });
+        }
+    }
+    emit settingChanged(key);
+}
+
+void ConfigManager::writePendingSettings()
+{
+    QHash<QString, QVariant> pending;
+    {
+        QMutexLocker locker(&m_pendingMutex);
+        pending.swap(m_pendingSettings);
+        m_settingsFlushScheduled = false;
+    }
+    const bool ok = pending.isEmpty() || writeSettingsToDb(pending);
+    // 写入线程空闲一段时间后会被线程池回收，连接不跨任务保留
+    releaseThreadConnection();
+    if (ok) {
+        if (m_settingsRetryMs != 0) {
+            LOG_INFO("设置写入已恢复");
+        }
+        m_settingsRetryMs = 0;
+        m_settingsFlushFailures = 0;
+        return;
+    }
+
+    // 缓存与 settingChanged 的接收方已经看到新值，失败的写入不能丢：
+    // 放回待写集合（不覆盖期间写入的更新值），按指数退避重试
+    QMutexLocker locker(&m_pendingMutex);
+    for (auto it = pending.constBegin(); it != pending.constEnd(); ++it) {
+        if (!m_pendingSettings.contains(it.key())) {
+            m_pendingSettings.insert(it.key(), it.value());
+        }
+    }
+    m_settingsRetryMs = m_settingsRetryMs == 0
+        ? kMinSettingsRetryMs
+        : qMin(m_settingsRetryMs * 2, kMaxSettingsRetryMs);
+    int delayMs = m_settingsRetryMs;
+    // 有调用方在 flushSettings() 中等待时（通常是退出前）只短暂重试有限次数
+    if (m_settingsFlushWaiters.load() > 0) {
+        if (++m_settingsFlushFailures >= kFlushSettingsAttempts) {
+            LOG_ERROR(QString("设置多次写入失败，放弃写入 %1 项: %2")
+                          .arg(m_pendingSettings.size())
+                          .arg(QStringList(m_pendingSettings.keys()).join(", ")));
+            m_pendingSettings.clear();
+            m_settingsFailuresDropped = true;
+            m_settingsFlushFailures = 0;
+            return;
+        }
+        delayMs = kMinSettingsRetryMs;
+    } else {
+        m_settingsFlushFailures = 0;
+    }
+    LOG_WARNING(QString("设置写入失败，%1 ms 后重试").arg(delayMs));
+    if (!m_settingsFlushScheduled) {
+        m_settingsFlushScheduled = true;
+        m_settingsWriter.start([this, delayMs]() {
+            // 写入线程池只有这一个线程，退避期间的新设置合并进待写集合，到时一并写入
+            QThread::msleep(static_cast<unsigned long>(delayMs));
+            writePendingSettings();
+        });
+    }
+}
+
+bool ConfigManager::writeSettingsToDb(const QHash<QString, QVariant> &settings)
+{
+    QSqlDatabase conn = database();
+    if (!conn.transaction()) {
+        LOG_ERROR(QString("开启事务失败: %1").arg(conn.lastError().text()));
+        return false;
+    }
+    QSqlQuery &query = statement(QStringLiteral("REPLACE INTO settings (key, value) VALUES (?, ?)"));
+    for (auto it = settings.constBegin(); it != settings.constEnd(); ++it) {
+        query.addBindValue(it.key());
+        query.addBindValue(it.value());
+        if (!query.exec()) {
+            LOG_ERROR(QString("写入设置失败 [%1]: %2").arg(it.key(), query.lastError().text()));
+            conn.rollback();
+            return false;
+        }
+    }
+    if (!conn.commit()) {
+        LOG_ERROR(QString("提交事务失败: %1").arg(conn.lastError().text()));
+        conn.rollback();
+        return false;
+    }
+    return true;
+}
+
+bool ConfigManager::flushSettings()
+{
+    m_settingsFlushWaiters.fetch_add(1);
+    m_settingsWriter.waitForDone();
+    m_settingsFlushWaiters.fetch_sub(1);
+    // 只报告一次：下一次 flushSettings 重新开始计数
+    QMutexLocker locker(&m_pendingMutex);
+    return !std::exchange(m_settingsFailuresDropped, false);
+}
+
+QVector<Reminder> ConfigManager::readRemindersFromDb() const
+{
+    QVector<Reminder> reminders;
+    // 在一个读事务中完成，迁移进行中时两张表看到的是同一时刻的内容
+    QSqlDatabase conn = database();
+    const bool inTransaction = conn.transaction();
+    QSqlQuery &count = statement(QStringLiteral("SELECT COUNT(*) FROM reminders_v2"));
+    if (count.exec() && count.next()) {
+        reminders.reserve(count.value(0).toInt());
+    }
+    count.finish();
+
+    QSqlQuery &query = statement(QString("SELECT %1 FROM reminders_v2").arg(ReminderRowCodec::columns()));
+    if (query.exec()) {
         while (query.next()) {
-            QJsonObject obj;
-            obj["id"] = query.value(0).toString();
-            obj["name"] = query.value(1).toString();
-            obj["type"] = query.value(2).toInt();
-            obj["priority"] = query.value(3).toInt();
-            obj["nextTrigger"] = query.value(4).toString();
-            obj["completed"] = query.value(5).toBool();
-            array.append(obj);
+            reminders.append(ReminderRowCodec::read(query));
         }
     } else {
         LOG_ERROR(QString("读取提醒失败: %1").arg(query.lastError().text()));
     }
-    return array;
+    query.finish();
+
+    if (m_legacyPending.load()) {
+        QSqlQuery legacy(conn);
+        legacy.setForwardOnly(true);
+        if (legacy.exec(QString("SELECT %1 FROM reminders WHERE id NOT IN (SELECT id FROM reminders_v2)")
+                            .arg(ReminderRowCodec::columns()))) {
+            while (legacy.next()) {
+                reminders.append(ReminderRowCodec::readLegacy(legacy));
+            }
+        } else {
+            LOG_ERROR(QString("读取旧提醒表失败: %1").arg(legacy.lastError().text()));
+        }
+    }
+    if (inTransaction) {
+        conn.commit();
+    }
+    return reminders;
 }
 
-void ConfigManager::writeRemindersToDb(const QJsonArray &reminders)
+void ConfigManager::writeRemindersToDb(const QVector<Reminder> &reminders)
 {
-    QSqlQuery query(db);
-    if (!query.exec(QStringLiteral("DELETE FROM reminders"))) {
-        LOG_ERROR(QString("清空提醒表失败: %1").arg(query.lastError().text()));
+    QSqlDatabase conn = database();
+    conn.transaction();
+    QSqlQuery &clear = statement(QStringLiteral("DELETE FROM reminders_v2"));
+    if (!clear.exec()) {
+        LOG_ERROR(QString("清空提醒表失败: %1").arg(clear.lastError().text()));
+        conn.rollback();
         return;
     }
-    query.prepare(QStringLiteral("INSERT INTO reminders (id, name, type, priority, next_trigger, completed) "
-                                 "VALUES (?, ?, ?, ?, ?, ?)"));
-    for (const QJsonValue &val : reminders) {
-        if (!val.isObject())
-            continue;
-        QJsonObject obj = val.toObject();
-        query.addBindValue(obj.value("id").toString());
-        query.addBindValue(obj.value("name").toString());
-        query.addBindValue(obj.value("type").toInt());
-        query.addBindValue(obj.value("priority").toInt());
-        query.addBindValue(obj.value("nextTrigger").toString());
-        query.addBindValue(obj.value("completed").toBool() ? 1 : 0);
+    if (m_legacyPending.load()) {
+        QSqlQuery clearLegacy(conn);
+        if (!clearLegacy.exec(QStringLiteral("DELETE FROM reminders"))) {
+            LOG_ERROR(QString("清空旧提醒表失败: %1").arg(clearLegacy.lastError().text()));
+            conn.rollback();
+            return;
+        }
+    }
+    QSqlQuery &query = statement(QString("INSERT INTO reminders_v2 (%1) VALUES (?, ?, ?, ?, ?, ?)")
+                                     .arg(ReminderRowCodec::columns()));
+    for (const Reminder &reminder : reminders) {
+        ReminderRowCodec::bind(query, reminder);
         if (!query.exec()) {
             LOG_ERROR(QString("写入提醒失败 (ID=%1): %2")
-                      .arg(obj.value("id").toString(),
+                      .arg(reminder.id(),
                            query.lastError().text()));
         }
-        query.clear();
-        query.prepare(QStringLiteral("INSERT INTO reminders (id, name, type, priority, next_trigger, completed) "
-                                     "VALUES (?, ?, ?, ?, ?, ?)"));
+    }
+    if (!conn.commit()) {
+        LOG_ERROR(QString("提交事务失败: %1").arg(conn.lastError().text()));
+        conn.rollback();
     }
 }
@@ -2,18 +2,45 @@
 #define CONFIGMANAGER_H
 
 #include <QObject>
-#include <QJsonArray>
+#include <QVector>
 #include <QCoreApplication>
 #include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QThreadStorage>
+#include <QHash>
+#include <QSet>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QThreadPool>
 #include <QVariant>
+#include <QStringList>
 #include "core/logging/logger.h"
+#include "core/reminders/reminder.h"
+#include <atomic>
+#include <memory>
 
+// 设置项在初始化时一次性读入内存缓存，读取不访问数据库；写入先更新缓存并发出
+// settingChanged，再由后台线程异步写入数据库（尚未落盘的同一键的多次写入合并为一次）。
+// 缓存按进程各自维护，另一个进程（界面与守护进程）对设置的修改在重启后才可见。
 class ConfigManager : public QObject
 {
     Q_OBJECT
 
 public:
     static ConfigManager& instance();
+    // 指定数据库文件（如模拟模式使用的临时库），必须在首次调用 instance() 之前设置
+    static void setDatabasePath(const QString &path);
+
+    // settingChanged 的参数取以下键名之一
+    static const QString PAUSED_KEY;
+    static const QString AUTO_START_KEY;
+    static const QString SOUND_ENABLED_KEY;
+    static const QString SCHEDULER_BACKEND_KEY;
+    static const QString JOURNAL_MAX_DELAY_KEY;
+    static const QString CATCH_UP_POLICY_KEY;
+    static const QString SCHEDULER_HORIZON_KEY;
+    static const QString DB_PROFILE_KEY;
+    static const QString MAX_POPUPS_KEY;
 
     // 提醒相关配置
     bool isPaused() const;
@@ -22,8 +49,54 @@ public:
     void setAutoStart(bool autoStart);
     bool isSoundEnabled() const;
     void setSoundEnabled(bool enabled);
-    QJsonArray getReminders() const;
-    void setReminders(const QJsonArray &reminders);
+    QString schedulerBackend() const;
+    void setSchedulerBackend(const QString &backend);
+    int journalMaxDelay() const;
+    void setJournalMaxDelay(int ms);
+    QString catchUpPolicy() const;
+    void setCatchUpPolicy(const QString &policy);
+    // 近期窗口（小时）：大于 0 时调度器只把该时长内到期的未完成提醒放在内存中，
+    // 其余留在数据库里随窗口滑动按范围查询调入；0 表示全部加载（默认）。下次启动生效
+    int schedulerHorizonHours() const;
+    void setSchedulerHorizonHours(int hours);
+    // 同一轮到期时最多弹出的窗口数，超出部分合并为一条汇总；0 表示每个提醒各弹一个（默认）
+    int maxPopups() const;
+    void setMaxPopups(int count);
+    // 数据库持久性/性能档位（journal_mode、synchronous、mmap_size、cache_size 的组合），
+    // 可选 durable/balanced/fast/legacy。设置后立即作用于当前线程的连接，其他线程的连接在下次打开时生效
+    QString dbProfile() const;
+    void setDbProfile(const QString &profile);
+    static QStringList dbProfiles();
+    QVector<Reminder> getReminders() const;
+    void setReminders(const QVector<Reminder> &reminders);
+    // 增量写入：upserts 中的提醒按 id 插入或更新，deletedIds 中的删除，同一事务内完成
+    bool applyReminderChanges(const QVector<Reminder> &upserts, const QStringList &deletedIds);
+    // 未完成且下次触发时间（UTC 纪元分钟）落在 [fromMinute, toMinute) 内的提醒，按 (completed, next_trigger) 索引做范围查询
+    QVector<Reminder> getRemindersDueBetween(qint64 fromMinute, qint64 toMinute) const;
+    // ids 中已存在于提醒表的那些，按主键逐个查询；近期窗口模式下用于不在内存中的提醒的查重
+    QSet<QString> existingReminderIds(const QStringList &ids) const;
+
+    // 表结构版本记录在 PRAGMA user_version 中。从版本 1（next_trigger 为 ISO 文本的 reminders 表）
+    // 升级时不阻塞启动：新表立即可用，旧表中的行由 migrateLegacyBatch 分批搬到新表，
+    // 期间读取合并两张表，删除同时作用于两张表。迁移与提醒写入应在同一线程上串行进行
+    bool legacyMigrationPending() const;
+    // 搬移至多 batchSize 行并在一个事务中提交，旧表搬空后删除它并写入新版本号。
+    // 返回本批搬移的行数，失败返回 -1
+    int migrateLegacyBatch(int batchSize);
+
+    // 每个线程使用独立的数据库连接；工作线程退出前应释放自己的连接
+    void releaseThreadConnection();
+
+    // 数据库文件的完整路径
+    QString databasePath() const;
+
+    // 阻塞直到此前写入的设置全部落盘，可在任意线程调用。写入持续失败时只短暂重试有限次数，
+    // 仍失败则放弃这些设置并返回 false
+    bool flushSettings();
+
+signals:
+    // 设置的值发生变化时在写入方线程上发出（缓存已更新，数据库可能尚未写入）
+    void settingChanged(const QString &key);
 
 private:
     explicit ConfigManager(QObject *parent = nullptr);
@@ -34,17 +107,60 @@ private:
     bool openDatabase();
     void ensureTables();
     QString getConfigPath() const;
+    QSqlDatabase database() const;
+    QString connectionName() const;
+    // 当前线程连接上按 SQL 文本缓存的预编译语句，首次使用时 prepare；查询语句用完后应调用 finish()
+    QSqlQuery &statement(const QString &sql) const;
+    void applyProfile(QSqlDatabase &conn) const;
+    // 缓存中的值一律是文本（布尔值为 "1"/"0"），调用方用 toBool()/toInt() 等取值
     QVariant readSetting(const QString &key, const QVariant &defaultValue) const;
+    // 与缓存中的值相同（转换为文本后比较）时不写入也不发通知
     void writeSetting(const QString &key, const QVariant &value);
-    QJsonArray readRemindersFromDb() const;
-    void writeRemindersToDb(const QJsonArray &reminders);
-    static void deduplicate(QJsonArray &reminders);
+    void loadSettings();
+    // 在设置写入线程上执行；失败时放回待写集合并安排退避重试
+    void writePendingSettings();
+    bool writeSettingsToDb(const QHash<QString, QVariant> &settings);
+    QVector<Reminder> readRemindersFromDb() const;
+    void writeRemindersToDb(const QVector<Reminder> &reminders);
+    static void deduplicate(QVector<Reminder> &reminders);
+
+    // 设置写入失败后的重试间隔从最小值起翻倍；flushSettings 等待期间最多再试的次数
+    static constexpr int kMinSettingsRetryMs = 100;
+    static constexpr int kMaxSettingsRetryMs = 5000;
+    static constexpr int kFlushSettingsAttempts = 4;
 
     static const QString CONFIG_DB;
-    static const QString PAUSED_KEY;
-    static const QString AUTO_START_KEY;
-    static const QString SOUND_ENABLED_KEY;
+    static const QString CONNECTION_NAME;
+    static QString databasePathOverride;
     QSqlDatabase db;
+
+    // 每个线程一份，与该线程的数据库连接同生命周期；释放连接前先清空
+    struct StatementCache {
+        QHash<QString, std::shared_ptr<QSqlQuery>> statements;
+        // 最近一次准备失败的语句，只为返回引用而保留
+        std::shared_ptr<QSqlQuery> invalid;
+    };
+    mutable QThreadStorage<StatementCache *> m_statements;
+    // 当前档位在 dbProfiles() 中的下标
+    std::atomic<int> m_profile;
+    // 旧版 reminders 表仍有待迁移的数据
+    std::atomic<bool> m_legacyPending;
+
+    // 设置缓存
+    QHash<QString, QVariant> m_settings;
+    mutable QReadWriteLock m_settingsLock;
+    // 已写入缓存、尚未落盘的设置；m_settingsFlushScheduled 表示已有写入任务在排队。
+    // 写入失败的设置放回这里按退避间隔重试；m_settingsFailuresDropped 表示 flushSettings 等待期间放弃过写入
+    QHash<QString, QVariant> m_pendingSettings;
+    bool m_settingsFlushScheduled;
+    bool m_settingsFailuresDropped;
+    QMutex m_pendingMutex;
+    // 重试间隔与 flushSettings 等待期间的连续失败次数，只在写入线程上访问
+    int m_settingsRetryMs;
+    int m_settingsFlushFailures;
+    std::atomic<int> m_settingsFlushWaiters;
+    // 单线程，保证设置按写入顺序落盘
+    QThreadPool m_settingsWriter;
 };
 
 #endif // CONFIGMANAGER_H 
@@ -0,0 +1,57 @@
+TEMPLATE = lib
+TARGET = easynotifycore
+CONFIG += staticlib
+
+# 核心库不依赖任何图形模块
+QT = core sql concurrent
+
+include(../../common.pri)
+
+INCLUDEPATH += $$PWD/..
+
+SOURCES += \
+    calendar/workdaycalendar.cpp \
+    config/configmanager.cpp \
+    logging/logger.cpp \
+    reminders/reminder.cpp \
+    reminders/reminderid.cpp \
+    reminders/reminderrowcodec.cpp \
+    reminders/namepool.cpp \
+    reminders/remindermanager.cpp \
+    reminders/triggerqueue.cpp \
+    reminders/heaptriggerqueue.cpp \
+    reminders/timingwheeltriggerqueue.cpp \
+    reminders/lineartriggerqueue.cpp \
+    reminders/duescan.cpp \
+    reminders/reminderjournal.cpp \
+    reminders/reminderstore.cpp \
+    reminders/latencyhistogram.cpp \
+    reminders/triggerstats.cpp \
+    reminders/recurrence.cpp \
+    time/clock.cpp
+
+HEADERS += \
+    calendar/workdaycalendar.h \
+    config/configmanager.h \
+    logging/logger.h \
+    reminders/reminder.h \
+    reminders/reminderid.h \
+    reminders/reminderrowcodec.h \
+    reminders/namepool.h \
+    reminders/remindermanager.h \
+    reminders/triggerqueue.h \
+    reminders/heaptriggerqueue.h \
+    reminders/timingwheeltriggerqueue.h \
+    reminders/lineartriggerqueue.h \
+    reminders/duescan.h \
+    reminders/reminderjournal.h \
+    reminders/reminderstore.h \
+    reminders/latencyhistogram.h \
+    reminders/triggerstats.h \
+    reminders/recurrence.h \
+    time/clock.h \
+    time/epochminute.h
+
+# 内置工作日数据
+RESOURCES += \
+    easynotifycore.qrc
@@ -0,0 +1,14 @@
+# 链接 EasyNotify 核心静态库，供 app 与 daemon 引用
+QT += sql concurrent
+
+INCLUDEPATH += $$PWD/..
+DEPENDPATH += $$PWD/..
+
+CORE_LIB_DIR = $$shadowed($$PWD)
+win32:CONFIG(release, debug|release): CORE_LIB_DIR = $$CORE_LIB_DIR/release
+else:win32:CONFIG(debug, debug|release): CORE_LIB_DIR = $$CORE_LIB_DIR/debug
+
+LIBS += -L$$CORE_LIB_DIR -leasynotifycore
+
+win32-msvc*: PRE_TARGETDEPS += $$CORE_LIB_DIR/easynotifycore.lib
+else: PRE_TARGETDEPS += $$CORE_LIB_DIR/libeasynotifycore.a
@@ -17,6 +17,7 @@ Logger& Logger::instance()
 
 Logger::Logger(QObject *parent)
     : QObject(parent)
+    , minimumLevel(static_cast<int>(LogLevel::Debug))
 {
     init();
 }
@@ -45,8 +46,16 @@ void Logger::init()
     } 
 }
 
+void Logger::setMinimumLevel(LogLevel level)
+{
+    minimumLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
 void Logger::log(LogLevel level, const QString& message, const QString& file, int line)
 {
+    if (static_cast<int>(level) < minimumLevel.load(std::memory_order_relaxed)) {
+        return;
+    }
     QMutexLocker locker(&mutex);
     QString formattedMessage = formatMessage(level, message, file, line);
     writeToFile(formattedMessage);
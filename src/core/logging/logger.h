@@ -8,6 +8,7 @@
 #include <QDateTime>
 #include <QDir>
 #include <QMutex>
+#include <atomic>
 
 class Logger : public QObject
 {
@@ -23,6 +24,8 @@ public:
 
     static Logger& instance();
     void log(LogLevel level, const QString& message, const QString& file, int line);
+    // 低于该级别的日志直接丢弃（模拟模式下用于屏蔽逐条触发日志）
+    void setMinimumLevel(LogLevel level);
 
     // 便捷的日志方法
     static void debug(const QString& message, const QString& file, int line) {
@@ -49,6 +52,7 @@ private:
     QFile logFile;
     QTextStream logStream;
     QMutex mutex;
+    std::atomic<int> minimumLevel;
     static const QString LOG_DIR;
 };
 
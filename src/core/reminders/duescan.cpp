@@ -0,0 +1,207 @@
+#include "core/reminders/duescan.h"
+#include <QtAlgorithms>
+#include <limits>
+
+#if defined(Q_PROCESSOR_X86) && (defined(__GNUC__) || defined(_MSC_VER))
+#  define DUESCAN_X86
+#  include <immintrin.h>
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+     // MSVC 无需按函数开启指令集，内建函数始终可用
+#    define DUESCAN_TARGET(isa)
+#  else
+#    define DUESCAN_TARGET(isa) __attribute__((target(isa)))
+#  endif
+#endif
+
+namespace DueScan {
+
+namespace {
+constexpr qint64 kNoMinimum = std::numeric_limits<qint64>::max();
+
+void collectScalar(const qint64 *minutes, int count, qint64 nowMinute, int base, QVector<int> &due)
+{
+    for (int i = 0; i < count; ++i) {
+        if (minutes[i] <= nowMinute) {
+            due.append(base + i);
+        }
+    }
+}
+
+qint64 minimumScalar(const qint64 *minutes, int count, qint64 best)
+{
+    for (int i = 0; i < count; ++i) {
+        best = qMin(best, minutes[i]);
+    }
+    return best;
+}
+
+// 比较结果的位掩码中每个置位对应一个到期下标
+void appendMaskBits(int mask, int base, QVector<int> &due)
+{
+    while (mask != 0) {
+        due.append(base + static_cast<int>(qCountTrailingZeroBits(static_cast<quint32>(mask))));
+        mask &= mask - 1;
+    }
+}
+
+#ifdef DUESCAN_X86
+DUESCAN_TARGET("avx2")
+void collectAvx2(const qint64 *minutes, int count, qint64 nowMinute, QVector<int> &due)
+{
+    const __m256i now = _mm256_set1_epi64x(nowMinute);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(minutes + i));
+        // 大于 now 的条目未到期，取反后即为到期位
+        const int later = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(values, now)));
+        appendMaskBits(~later & 0xF, i, due);
+    }
+    collectScalar(minutes + i, count - i, nowMinute, i, due);
+}
+
+DUESCAN_TARGET("avx2")
+qint64 minimumAvx2(const qint64 *minutes, int count)
+{
+    __m256i best = _mm256_set1_epi64x(kNoMinimum);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(minutes + i));
+        best = _mm256_blendv_epi8(best, values, _mm256_cmpgt_epi64(best, values));
+    }
+    alignas(32) qint64 lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), best);
+    return minimumScalar(minutes + i, count - i, minimumScalar(lanes, 4, kNoMinimum));
+}
+
+DUESCAN_TARGET("sse4.2")
+void collectSse42(const qint64 *minutes, int count, qint64 nowMinute, QVector<int> &due)
+{
+    const __m128i now = _mm_set1_epi64x(nowMinute);
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(minutes + i));
+        const int later = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(values, now)));
+        appendMaskBits(~later & 0x3, i, due);
+    }
+    collectScalar(minutes + i, count - i, nowMinute, i, due);
+}
+
+DUESCAN_TARGET("sse4.2")
+qint64 minimumSse42(const qint64 *minutes, int count)
+{
+    __m128i best = _mm_set1_epi64x(kNoMinimum);
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(minutes + i));
+        best = _mm_blendv_epi8(best, values, _mm_cmpgt_epi64(best, values));
+    }
+    alignas(16) qint64 lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i *>(lanes), best);
+    return minimumScalar(minutes + i, count - i, minimumScalar(lanes, 2, kNoMinimum));
+}
+
+Kernel detectKernel()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = {0, 0, 0, 0};
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    const bool sse42 = (info[2] & (1 << 20)) != 0;
+    // AVX 寄存器需要操作系统通过 XSAVE 保存，否则即使 CPU 支持也不能用
+    const bool osAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0
+        && (_xgetbv(0) & 0x6) == 0x6;
+    bool avx2 = false;
+    if (osAvx && maxLeaf >= 7) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    const bool sse42 = __builtin_cpu_supports("sse4.2");
+    const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+    if (avx2) {
+        return Kernel::Avx2;
+    }
+    return sse42 ? Kernel::Sse42 : Kernel::Scalar;
+}
+#else
+Kernel detectKernel()
+{
+    return Kernel::Scalar;
+}
+#endif
+}
+
+Kernel activeKernel()
+{
+    static const Kernel kernel = detectKernel();
+    return kernel;
+}
+
+bool isSupported(Kernel kernel)
+{
+    return static_cast<int>(kernel) <= static_cast<int>(activeKernel());
+}
+
+QString kernelName(Kernel kernel)
+{
+    switch (kernel) {
+    case Kernel::Avx2: return QStringLiteral("avx2");
+    case Kernel::Sse42: return QStringLiteral("sse4.2");
+    case Kernel::Scalar:
+    default: return QStringLiteral("scalar");
+    }
+}
+
+void collect(const qint64 *minutes, int count, qint64 nowMinute, QVector<int> &due)
+{
+    collect(activeKernel(), minutes, count, nowMinute, due);
+}
+
+void collect(Kernel kernel, const qint64 *minutes, int count, qint64 nowMinute, QVector<int> &due)
+{
+    // 不支持的指令集退回到可用的最快实现
+    if (!isSupported(kernel)) {
+        kernel = activeKernel();
+    }
+    switch (kernel) {
+#ifdef DUESCAN_X86
+    case Kernel::Avx2:
+        collectAvx2(minutes, count, nowMinute, due);
+        return;
+    case Kernel::Sse42:
+        collectSse42(minutes, count, nowMinute, due);
+        return;
+#endif
+    default:
+        collectScalar(minutes, count, nowMinute, 0, due);
+        return;
+    }
+}
+
+qint64 minimum(const qint64 *minutes, int count)
+{
+    return minimum(activeKernel(), minutes, count);
+}
+
+qint64 minimum(Kernel kernel, const qint64 *minutes, int count)
+{
+    if (!isSupported(kernel)) {
+        kernel = activeKernel();
+    }
+    switch (kernel) {
+#ifdef DUESCAN_X86
+    case Kernel::Avx2:
+        return minimumAvx2(minutes, count);
+    case Kernel::Sse42:
+        return minimumSse42(minutes, count);
+#endif
+    default:
+        return minimumScalar(minutes, count, kNoMinimum);
+    }
+}
+
+}
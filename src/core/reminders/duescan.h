@@ -0,0 +1,33 @@
+#ifndef DUESCAN_H
+#define DUESCAN_H
+
+#include <QString>
+#include <QVector>
+
+// 对连续存放的纪元分钟数组做到期扫描的向量化内核。
+// x86 上按运行时检测到的指令集选择 AVX2（一次 4 个）或 SSE4.2（一次 2 个，
+// 64 位比较 pcmpgtq 需要 SSE4.2），其余平台使用标量实现；各实现结果完全一致。
+namespace DueScan {
+
+enum class Kernel {
+    Scalar,
+    Sse42,
+    Avx2
+};
+
+// 当前 CPU 上最快的可用实现
+Kernel activeKernel();
+bool isSupported(Kernel kernel);
+QString kernelName(Kernel kernel);
+
+// 把 minutes[0, count) 中不晚于 nowMinute 的下标按升序追加到 due
+void collect(const qint64 *minutes, int count, qint64 nowMinute, QVector<int> &due);
+void collect(Kernel kernel, const qint64 *minutes, int count, qint64 nowMinute, QVector<int> &due);
+
+// minutes[0, count) 中的最小值；count 为 0 时返回 qint64 最大值
+qint64 minimum(const qint64 *minutes, int count);
+qint64 minimum(Kernel kernel, const qint64 *minutes, int count);
+
+}
+
+#endif // DUESCAN_H
@@ -0,0 +1,101 @@
+#include "core/reminders/heaptriggerqueue.h"
+#include <algorithm>
+
+namespace {
+// 堆顶为最早到期；同一时间按入队顺序
+struct Later {
+    template <typename T>
+    bool operator()(const T &a, const T &b) const
+    {
+        return a.due != b.due ? a.due > b.due : a.seq > b.seq;
+    }
+};
+}
+
+void HeapTriggerQueue::schedule(const ReminderId &id, qint64 dueMinute)
+{
+    if (dueMinute == EpochMinute::kInvalid) {
+        cancel(id);
+        return;
+    }
+    const quint64 seq = m_nextSeq++;
+    m_live.insert(id, seq);
+    m_heap.push_back({dueMinute, seq, id});
+    std::push_heap(m_heap.begin(), m_heap.end(), Later());
+    pruneTop();
+    rebuildIfSparse();
+}
+
+void HeapTriggerQueue::cancel(const ReminderId &id)
+{
+    if (m_live.remove(id) == 0) {
+        return;
+    }
+    pruneTop();
+    rebuildIfSparse();
+}
+
+void HeapTriggerQueue::clear()
+{
+    m_heap.clear();
+    m_live.clear();
+}
+
+qint64 HeapTriggerQueue::nextDue() const
+{
+    // 每次修改后都会清理堆顶，因此堆顶一定是有效条目
+    if (m_heap.empty()) {
+        return EpochMinute::kInvalid;
+    }
+    return m_heap.front().due;
+}
+
+QVector<ReminderId> HeapTriggerQueue::takeDue(qint64 nowMinute)
+{
+    QVector<ReminderId> due;
+    while (!m_heap.empty() && m_heap.front().due <= nowMinute) {
+        const ReminderId id = m_heap.front().id;
+        popTop();
+        m_live.remove(id);
+        due.append(id);
+        pruneTop();
+    }
+    return due;
+}
+
+bool HeapTriggerQueue::isStale(const Entry &entry) const
+{
+    auto it = m_live.constFind(entry.id);
+    return it == m_live.constEnd() || it.value() != entry.seq;
+}
+
+void HeapTriggerQueue::popTop()
+{
+    std::pop_heap(m_heap.begin(), m_heap.end(), Later());
+    m_heap.pop_back();
+}
+
+void HeapTriggerQueue::pruneTop()
+{
+    while (!m_heap.empty() && isStale(m_heap.front())) {
+        popTop();
+    }
+}
+
+void HeapTriggerQueue::rebuildIfSparse()
+{
+    // 失效条目过多时整体重建，保证堆大小与有效条目数同阶
+    const size_t live = static_cast<size_t>(m_live.size());
+    if (m_heap.size() <= 2 * live + 64) {
+        return;
+    }
+    std::vector<Entry> rebuilt;
+    rebuilt.reserve(live);
+    for (const Entry &entry : m_heap) {
+        if (!isStale(entry)) {
+            rebuilt.push_back(entry);
+        }
+    }
+    std::make_heap(rebuilt.begin(), rebuilt.end(), Later());
+    m_heap.swap(rebuilt);
+}
@@ -0,0 +1,38 @@
+#ifndef HEAPTRIGGERQUEUE_H
+#define HEAPTRIGGERQUEUE_H
+
+#include <QHash>
+#include <vector>
+#include "core/reminders/triggerqueue.h"
+
+// 以 nextTrigger 为键的最小堆。
+// 重新调度/取消采用惰性删除：旧条目留在堆中，出堆时按序号识别并丢弃。
+class HeapTriggerQueue : public TriggerQueue
+{
+public:
+    void schedule(const ReminderId &id, qint64 dueMinute) override;
+    void cancel(const ReminderId &id) override;
+    void clear() override;
+
+    int size() const override { return m_live.size(); }
+    qint64 nextDue() const override;
+    QVector<ReminderId> takeDue(qint64 nowMinute) override;
+
+private:
+    struct Entry {
+        qint64 due; // 纪元分钟
+        quint64 seq;
+        ReminderId id;
+    };
+
+    bool isStale(const Entry &entry) const;
+    void popTop();
+    void pruneTop();
+    void rebuildIfSparse();
+
+    std::vector<Entry> m_heap;
+    QHash<ReminderId, quint64> m_live; // id -> 当前有效条目的序号
+    quint64 m_nextSeq = 0;
+};
+
+#endif // HEAPTRIGGERQUEUE_H
@@ -0,0 +1,82 @@
+#include "core/reminders/latencyhistogram.h"
+#include <cmath>
+
+namespace {
+// 低于 kSubBuckets 的值逐一计数；之后每个 2 的幂区间分为 kHalfSubBuckets 格
+constexpr int kSubBucketBits = 6;
+constexpr int kSubBuckets = 1 << kSubBucketBits;
+constexpr int kHalfSubBuckets = kSubBuckets / 2;
+// 覆盖到 2^41 微秒（约 25 天），更大的值计入最后一格
+constexpr int kMaxExponent = 40;
+constexpr int kBucketCount = kSubBuckets + (kMaxExponent - kSubBucketBits + 1) * kHalfSubBuckets;
+
+int highestBit(quint64 value)
+{
+    int bit = 0;
+    while (value >>= 1) {
+        ++bit;
+    }
+    return bit;
+}
+}
+
+LatencyHistogram::LatencyHistogram()
+    : m_buckets(kBucketCount, 0)
+    , m_count(0)
+    , m_max(0)
+{
+}
+
+void LatencyHistogram::record(qint64 valueUs)
+{
+    const qint64 value = qMax<qint64>(0, valueUs);
+    ++m_buckets[bucketIndex(value)];
+    ++m_count;
+    m_max = qMax(m_max, value);
+}
+
+void LatencyHistogram::reset()
+{
+    m_buckets.fill(0);
+    m_count = 0;
+    m_max = 0;
+}
+
+qint64 LatencyHistogram::valueAtPercentile(double percentile) const
+{
+    if (m_count == 0) {
+        return 0;
+    }
+    const double clamped = qBound(0.0, percentile, 100.0);
+    const qint64 target = qMax<qint64>(1, static_cast<qint64>(std::ceil(clamped / 100.0 * m_count)));
+    qint64 seen = 0;
+    for (int i = 0; i < m_buckets.size(); ++i) {
+        seen += m_buckets[i];
+        if (seen >= target) {
+            return qMin(bucketUpperBound(i), m_max);
+        }
+    }
+    return m_max;
+}
+
+int LatencyHistogram::bucketIndex(qint64 value)
+{
+    if (value < kSubBuckets) {
+        return static_cast<int>(value);
+    }
+    const int exponent = qMin(highestBit(static_cast<quint64>(value)), kMaxExponent);
+    const int shift = exponent - (kSubBucketBits - 1);
+    const qint64 sub = qMin<qint64>(value >> shift, kSubBuckets - 1) - kHalfSubBuckets;
+    return kSubBuckets + (exponent - kSubBucketBits) * kHalfSubBuckets + static_cast<int>(sub);
+}
+
+qint64 LatencyHistogram::bucketUpperBound(int index)
+{
+    if (index < kSubBuckets) {
+        return index;
+    }
+    const int exponent = kSubBucketBits + (index - kSubBuckets) / kHalfSubBuckets;
+    const int shift = exponent - (kSubBucketBits - 1);
+    const qint64 sub = kHalfSubBuckets + (index - kSubBuckets) % kHalfSubBuckets;
+    return ((sub + 1) << shift) - 1;
+}
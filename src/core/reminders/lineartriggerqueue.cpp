@@ -0,0 +1,73 @@
+#include "core/reminders/lineartriggerqueue.h"
+#include "core/reminders/duescan.h"
+
+void LinearTriggerQueue::schedule(const ReminderId &id, qint64 dueMinute)
+{
+    if (dueMinute == EpochMinute::kInvalid) {
+        cancel(id);
+        return;
+    }
+    auto it = m_slots.constFind(id);
+    if (it != m_slots.constEnd()) {
+        m_dueMinutes[it.value()] = dueMinute;
+        return;
+    }
+    m_slots.insert(id, m_dueMinutes.size());
+    m_dueMinutes.append(dueMinute);
+    m_ids.append(id);
+}
+
+void LinearTriggerQueue::cancel(const ReminderId &id)
+{
+    auto it = m_slots.find(id);
+    if (it == m_slots.end()) {
+        return;
+    }
+    const int slot = it.value();
+    m_slots.erase(it);
+    removeAt(slot);
+}
+
+void LinearTriggerQueue::clear()
+{
+    m_dueMinutes.clear();
+    m_ids.clear();
+    m_slots.clear();
+}
+
+qint64 LinearTriggerQueue::nextDue() const
+{
+    if (m_dueMinutes.isEmpty()) {
+        return EpochMinute::kInvalid;
+    }
+    return DueScan::minimum(m_dueMinutes.constData(), m_dueMinutes.size());
+}
+
+QVector<ReminderId> LinearTriggerQueue::takeDue(qint64 nowMinute)
+{
+    QVector<int> slots;
+    DueScan::collect(m_dueMinutes.constData(), m_dueMinutes.size(), nowMinute, slots);
+
+    QVector<ReminderId> due;
+    due.reserve(slots.size());
+    // 从后往前删除：填补空位的末尾元素要么未到期，要么已经取出
+    for (int i = slots.size() - 1; i >= 0; --i) {
+        const int slot = slots.at(i);
+        due.append(m_ids.at(slot));
+        m_slots.remove(m_ids.at(slot));
+        removeAt(slot);
+    }
+    return due;
+}
+
+void LinearTriggerQueue::removeAt(int slot)
+{
+    const int last = m_dueMinutes.size() - 1;
+    if (slot != last) {
+        m_dueMinutes[slot] = m_dueMinutes.at(last);
+        m_ids[slot] = m_ids.at(last);
+        m_slots[m_ids.at(slot)] = slot;
+    }
+    m_dueMinutes.removeLast();
+    m_ids.removeLast();
+}
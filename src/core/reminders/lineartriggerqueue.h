@@ -0,0 +1,30 @@
+#ifndef LINEARTRIGGERQUEUE_H
+#define LINEARTRIGGERQUEUE_H
+
+#include <QHash>
+#include <QVector>
+#include "core/reminders/triggerqueue.h"
+
+// 与旧版轮询一致的线性扫描实现：修改 O(1)，查询/取出到期 O(n)。
+// 到期分钟与 ID 分列存放（结构数组），扫描只读连续的 8 字节分钟列，
+// 由 DueScan 的向量化内核比较；删除时用末尾元素填补空位。
+class LinearTriggerQueue : public TriggerQueue
+{
+public:
+    void schedule(const ReminderId &id, qint64 dueMinute) override;
+    void cancel(const ReminderId &id) override;
+    void clear() override;
+
+    int size() const override { return m_dueMinutes.size(); }
+    qint64 nextDue() const override;
+    QVector<ReminderId> takeDue(qint64 nowMinute) override;
+
+private:
+    void removeAt(int slot);
+
+    QVector<qint64> m_dueMinutes;
+    QVector<ReminderId> m_ids;
+    QHash<ReminderId, int> m_slots; // id -> 列下标
+};
+
+#endif // LINEARTRIGGERQUEUE_H
@@ -0,0 +1,122 @@
+#include "core/reminders/namepool.h"
+#include <QtAlgorithms>
+
+NamePool &NamePool::instance()
+{
+    // 有意不析构：静态对象析构顺序不定，退出时可能仍有提醒在释放名称引用
+    static NamePool *pool = new NamePool;
+    return *pool;
+}
+
+NamePool::NamePool()
+    : m_nextIndex(1)
+{
+    for (std::atomic<Entry *> &chunk : m_chunks) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+    m_chunks[0].store(new Entry[kFirstChunkSize], std::memory_order_release);
+}
+
+int NamePool::chunkOf(quint32 index)
+{
+    const quint64 block = index / kFirstChunkSize + 1;
+    return 63 - static_cast<int>(qCountLeadingZeroBits(block));
+}
+
+NamePool::Entry *NamePool::entry(quint32 index) const
+{
+    const int chunk = chunkOf(index);
+    return m_chunks[chunk].load(std::memory_order_acquire) + (index - chunkBase(chunk));
+}
+
+quint32 NamePool::intern(const QString &name)
+{
+    if (name.isEmpty()) {
+        return 0;
+    }
+    {
+        QReadLocker locker(&m_lock);
+        auto it = m_indices.constFind(name);
+        if (it != m_indices.constEnd()) {
+            entry(it.value())->ref.ref();
+            return it.value();
+        }
+    }
+
+    QWriteLocker locker(&m_lock);
+    // 读锁释放后可能已有其他线程插入了同一名称
+    auto it = m_indices.constFind(name);
+    if (it != m_indices.constEnd()) {
+        entry(it.value())->ref.ref();
+        return it.value();
+    }
+    quint32 index;
+    if (!m_freeIndices.isEmpty()) {
+        index = m_freeIndices.takeLast();
+    } else {
+        index = m_nextIndex++;
+        const int chunk = chunkOf(index);
+        if (!m_chunks[chunk].load(std::memory_order_relaxed)) {
+            m_chunks[chunk].store(new Entry[static_cast<size_t>(kFirstChunkSize) << chunk],
+                                  std::memory_order_release);
+        }
+    }
+    Entry *item = entry(index);
+    item->name = name;
+    item->ref.storeRelease(1);
+    m_indices.insert(name, index);
+    return index;
+}
+
+void NamePool::retain(quint32 index)
+{
+    // 调用方已持有该下标的引用，项不会在此期间被回收，无需加锁
+    entry(index)->ref.ref();
+}
+
+void NamePool::release(quint32 index)
+{
+    Entry *item = entry(index);
+    // 不是最后一个引用时直接递减；可能降到 0 时改在写锁内进行，避免与 intern 复活同一项竞争
+    for (int count = item->ref.loadRelaxed(); count > 1; count = item->ref.loadRelaxed()) {
+        if (item->ref.testAndSetOrdered(count, count - 1)) {
+            return;
+        }
+    }
+
+    QWriteLocker locker(&m_lock);
+    if (!item->ref.deref()) {
+        m_indices.remove(item->name);
+        item->name = QString();
+        m_freeIndices.append(index);
+    }
+}
+
+QString NamePool::name(quint32 index) const
+{
+    return entry(index)->name;
+}
+
+int NamePool::size() const
+{
+    QReadLocker locker(&m_lock);
+    return m_indices.size() + 1;
+}
+
+qint64 NamePool::approximateBytes() const
+{
+    QReadLocker locker(&m_lock);
+    // 已分配的块、在用名称的字符串数据（UTF-16 + 头部）、空闲下标与哈希节点（键与下标）
+    qint64 bytes = 0;
+    for (int chunk = 0; chunk < kChunkCount; ++chunk) {
+        if (m_chunks[chunk].load(std::memory_order_relaxed)) {
+            bytes += static_cast<qint64>(sizeof(Entry)) * (qint64(kFirstChunkSize) << chunk);
+        }
+    }
+    for (auto it = m_indices.constBegin(); it != m_indices.constEnd(); ++it) {
+        bytes += 16 + static_cast<qint64>(it.key().capacity()) * sizeof(QChar);
+    }
+    bytes += static_cast<qint64>(m_freeIndices.capacity()) * sizeof(quint32);
+    bytes += static_cast<qint64>(m_indices.capacity()) * (sizeof(QString) + sizeof(quint32) + 8);
+    return bytes;
+}
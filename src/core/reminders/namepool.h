@@ -0,0 +1,97 @@
+#ifndef NAMEPOOL_H
+#define NAMEPOOL_H
+
+#include <QAtomicInt>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <utility>
+
+// 提醒名称的驻留池：相同的名称只保存一份，提醒里只记录 32 位下标。
+// 每个名称带引用计数，最后一个引用释放后该下标回收复用（下标 0 固定为空串，不计数），
+// 池的大小取决于当前仍在使用的不同名称个数。可在任意线程调用。
+// 名称按块存放，块分配后地址不变，持有下标引用期间对应的项不会被回收或改写，
+// 因此 name() 不加锁，只复制一次隐式共享的 QString。
+class NamePool
+{
+public:
+    static NamePool &instance();
+
+    // 返回的下标已持有一次引用，用完后应调用 release()
+    quint32 intern(const QString &name);
+    void retain(quint32 index);
+    void release(quint32 index);
+    QString name(quint32 index) const;
+
+    // 当前在用的名称数（含下标 0 的空串）
+    int size() const;
+    // 池中字符串数据与索引的大致字节数，用于内存基准
+    qint64 approximateBytes() const;
+
+private:
+    NamePool();
+
+    struct Entry {
+        QAtomicInt ref;
+        QString name;
+    };
+    // 第 k 块容纳 kFirstChunkSize << k 项，27 块足以覆盖全部 32 位下标
+    static constexpr int kFirstChunkSize = 64;
+    static constexpr int kChunkCount = 27;
+
+    static int chunkOf(quint32 index);
+    static quint32 chunkBase(int chunk) { return static_cast<quint32>(kFirstChunkSize * ((quint64(1) << chunk) - 1)); }
+    Entry *entry(quint32 index) const;
+
+    // 计数降到 0、回收下标与新建名称只在写锁内进行；读锁内查到的项计数总大于 0
+    mutable QReadWriteLock m_lock;
+    std::atomic<Entry *> m_chunks[kChunkCount];
+    quint32 m_nextIndex;
+    QVector<quint32> m_freeIndices;
+    QHash<QString, quint32> m_indices;
+};
+
+// 提醒中保存的名称引用：只有 4 字节，复制时引用计数加一，析构时减一
+class PooledName
+{
+public:
+    PooledName() = default;
+    explicit PooledName(const QString &name) : m_index(NamePool::instance().intern(name)) {}
+    PooledName(const PooledName &other) : m_index(other.m_index)
+    {
+        if (m_index != 0) {
+            NamePool::instance().retain(m_index);
+        }
+    }
+    PooledName(PooledName &&other) noexcept : m_index(std::exchange(other.m_index, 0u)) {}
+    PooledName &operator=(const PooledName &other)
+    {
+        PooledName copy(other);
+        std::swap(m_index, copy.m_index);
+        return *this;
+    }
+    PooledName &operator=(PooledName &&other) noexcept
+    {
+        std::swap(m_index, other.m_index);
+        return *this;
+    }
+    ~PooledName()
+    {
+        if (m_index != 0) {
+            NamePool::instance().release(m_index);
+        }
+    }
+
+    QString toString() const { return m_index != 0 ? NamePool::instance().name(m_index) : QString(); }
+
+    // 名称已驻留，下标相同即名称相同
+    bool operator==(const PooledName &other) const { return m_index == other.m_index; }
+    bool operator!=(const PooledName &other) const { return m_index != other.m_index; }
+
+private:
+    quint32 m_index = 0;
+};
+
+#endif // NAMEPOOL_H
@@ -0,0 +1,79 @@
+#include "core/reminders/recurrence.h"
+#include "core/calendar/workdaycalendar.h"
+
+Recurrence::Advance Recurrence::advance(const Reminder &reminder, const QDateTime &now)
+{
+    const QDateTime due = reminder.nextTrigger();
+    switch (reminder.type()) {
+    case Reminder::Type::Daily:
+        return advanceDaily(due, now);
+    case Reminder::Type::Workday:
+        return advanceWorkday(due, now);
+    case Reminder::Type::Once:
+    default:
+        break;
+    }
+    Advance result;
+    result.occurrences = (due.isValid() && due <= now) ? 1 : 0;
+    return result;
+}
+
+Recurrence::Advance Recurrence::advanceDaily(const QDateTime &due, const QDateTime &now)
+{
+    Advance result;
+    if (!due.isValid() || due > now) {
+        result.next = due;
+        return result;
+    }
+    const QTime time = due.time();
+    QDateTime next(now.date(), time);
+    if (next <= now) {
+        next = QDateTime(now.date().addDays(1), time);
+    }
+    result.next = next;
+    result.occurrences = static_cast<int>(due.date().daysTo(next.date()));
+    return result;
+}
+
+Recurrence::Advance Recurrence::advanceWorkday(const QDateTime &due, const QDateTime &now)
+{
+    Advance result;
+    if (due.isValid() && due > now) {
+        result.next = due;
+        return result;
+    }
+    // 没有有效触发时间时以当前时刻为准，从下一个工作日开始
+    const QTime time = due.isValid() ? due.time() : now.time();
+    const QDate candidate = QDateTime(now.date(), time) > now ? now.date() : now.date().addDays(1);
+
+    WorkdayCalendar &calendar = WorkdayCalendar::instance();
+    const QDate nextDate = calendar.nextWorkday(candidate, true);
+    result.next = QDateTime(nextDate.isValid() ? nextDate : candidate, time);
+    if (due.isValid()) {
+        // 到期日本身即使不是工作日也算作一次
+        result.occurrences = qMax(1, calendar.workdaysBetween(due.date(), candidate.addDays(-1)));
+    }
+    return result;
+}
+
+Recurrence::CatchUpPolicy Recurrence::policyFromString(const QString &name)
+{
+    const QString key = name.trimmed().toLower();
+    if (key == QLatin1String("all")) {
+        return CatchUpPolicy::FireAll;
+    }
+    if (key == QLatin1String("skip")) {
+        return CatchUpPolicy::Skip;
+    }
+    return CatchUpPolicy::FireOnce;
+}
+
+QString Recurrence::policyName(CatchUpPolicy policy)
+{
+    switch (policy) {
+    case CatchUpPolicy::FireAll: return QStringLiteral("all");
+    case CatchUpPolicy::Skip: return QStringLiteral("skip");
+    case CatchUpPolicy::FireOnce:
+    default: return QStringLiteral("once");
+    }
+}
@@ -0,0 +1,36 @@
+#ifndef RECURRENCE_H
+#define RECURRENCE_H
+
+#include <QDateTime>
+#include <QString>
+#include "core/reminders/reminder.h"
+
+// 重复提醒的推进规则：直接算出严格晚于 now 的下一次触发时间，
+// 并统计从当前 nextTrigger 到 now 之间本应触发的次数。
+// 每日提醒为 O(1) 闭式计算，工作日提醒借助日历的区间计数为 O(log n)。
+class Recurrence
+{
+public:
+    // 程序关闭/休眠期间错过触发时的补发策略
+    enum class CatchUpPolicy {
+        FireOnce, // 只触发一次
+        FireAll,  // 发出一条带错过次数的汇总通知
+        Skip      // 不补发，直接跳到下一次
+    };
+
+    struct Advance {
+        QDateTime next;      // 下一次触发时间；一次性提醒为无效值
+        int occurrences = 0; // [nextTrigger, now] 内应触发的次数
+    };
+
+    static Advance advance(const Reminder &reminder, const QDateTime &now);
+
+    static CatchUpPolicy policyFromString(const QString &name);
+    static QString policyName(CatchUpPolicy policy);
+
+private:
+    static Advance advanceDaily(const QDateTime &due, const QDateTime &now);
+    static Advance advanceWorkday(const QDateTime &due, const QDateTime &now);
+};
+
+#endif // RECURRENCE_H
@@ -1,9 +1,9 @@
 #include "core/reminders/reminder.h"
-#include <QUuid>
 #include "core/logging/logger.h"
 
-namespace {
-Reminder::Type typeFromInt(int value)
+static_assert(sizeof(Reminder) <= 32, "Reminder 应保持紧凑布局");
+
+Reminder::Type Reminder::typeFromInt(int value)
 {
     switch (value) {
     case 0: return Reminder::Type::Once;
@@ -13,7 +13,7 @@ Reminder::Type typeFromInt(int value)
     }
 }
 
-Reminder::Priority priorityFromInt(int value)
+Reminder::Priority Reminder::priorityFromInt(int value)
 {
     switch (value) {
     case 0: return Reminder::Priority::Low;
@@ -22,42 +22,50 @@ Reminder::Priority priorityFromInt(int value)
     default: return Reminder::Priority::Medium;
     }
 }
-}
-
 
 QJsonObject Reminder::toJson() const
 {
-    LOG_INFO(QString("序列化提醒: ID='%1', 名称='%2'").arg(m_id).arg(m_name));
     QJsonObject json;
-    json["id"] = m_id;
-    json["name"] = m_name;
-    json["type"] = static_cast<int>(m_type);
-    json["priority"] = static_cast<int>(m_priority);
-    json["nextTrigger"] = m_nextTrigger.toString(Qt::ISODate);
-    json["completed"] = m_completed;
-
-    LOG_INFO(QString("提醒序列化完成: ID='%1'").arg(m_id));
+    json["id"] = id();
+    json["name"] = name();
+    json["type"] = static_cast<int>(type());
+    json["priority"] = static_cast<int>(priority());
+    json["nextTrigger"] = nextTrigger().toString(Qt::ISODate);
+    json["completed"] = completed();
     return json;
 }
 
 Reminder Reminder::fromJson(const QJsonObject &json)
 {
-    QString id = json["id"].toString();
-    QString name = json["name"].toString();
-    LOG_INFO(QString("反序列化提醒: ID='%1', 名称='%2'").arg(id).arg(name));
-    
     Reminder reminder;
-    reminder.m_id = id;
-    reminder.m_name = name;
-    reminder.m_type = typeFromInt(json["type"].toInt());
-    reminder.m_priority = json.contains("priority")
+    reminder.setId(json["id"].toString());
+    reminder.setName(json["name"].toString());
+    reminder.setType(typeFromInt(json["type"].toInt()));
+    reminder.setPriority(json.contains("priority")
         ? priorityFromInt(json["priority"].toInt())
-        : Priority::Medium;
-    reminder.m_nextTrigger = QDateTime::fromString(json["nextTrigger"].toString(), Qt::ISODate);
-    reminder.m_completed = json.contains("completed") ? json["completed"].toBool() : false;
-
-    LOG_INFO(QString("提醒反序列化完成: ID='%1', 类型=%2")
-             .arg(id)
-             .arg(static_cast<int>(reminder.m_type)));
+        : Priority::Medium);
+    reminder.setNextTrigger(QDateTime::fromString(json["nextTrigger"].toString(), Qt::ISODate));
+    reminder.setCompleted(json.contains("completed") ? json["completed"].toBool() : false);
     return reminder;
 }
+
+Reminder::Fields Reminder::changedFields(const Reminder &other) const
+{
+    Fields fields;
+    if (m_name != other.m_name) {
+        fields |= Field::Name;
+    }
+    if ((m_flags & kTypeMask) != (other.m_flags & kTypeMask)) {
+        fields |= Field::Type;
+    }
+    if ((m_flags & kPriorityMask) != (other.m_flags & kPriorityMask)) {
+        fields |= Field::Priority;
+    }
+    if (m_nextTriggerMinute != other.m_nextTriggerMinute) {
+        fields |= Field::NextTrigger;
+    }
+    if ((m_flags & kCompletedBit) != (other.m_flags & kCompletedBit)) {
+        fields |= Field::Completed;
+    }
+    return fields;
+}
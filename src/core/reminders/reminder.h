@@ -4,8 +4,15 @@
 #include <QString>
 #include <QDateTime>
 #include <QJsonObject>
+#include <QFlags>
 #include "core/logging/logger.h"
+#include "core/time/epochminute.h"
+#include "core/reminders/reminderid.h"
+#include "core/reminders/namepool.h"
 
+// 提醒的紧凑表示（32 字节，无堆分配）：128 位 ID、UTC 纪元分钟触发时间、
+// 名称驻留池下标（带引用计数），以及打包在一个字节里的类型/优先级/完成状态。
+// 对外接口仍以 QString/QDateTime 提供，界面与持久化无需感知内部布局。
 class Reminder {
 public:
     enum class Type {
@@ -18,37 +25,59 @@ public:
         Medium,
         High
     };
+    // 变更通知中标记哪些字段发生了变化
+    enum class Field : quint8 {
+        Name = 0x01,
+        Type = 0x02,
+        Priority = 0x04,
+        NextTrigger = 0x08,
+        Completed = 0x10
+    };
+    Q_DECLARE_FLAGS(Fields, Field)
 
     Reminder() = default;
 
     // Getters
-    QString name() const { return m_name; }
-    Type type() const { return m_type; }
-    QDateTime nextTrigger() const { return m_nextTrigger; }
-    QString id() const { return m_id; }
-    bool completed() const { return m_completed; }
-    Priority priority() const { return m_priority; }
+    QString name() const { return m_name.toString(); }
+    Type type() const { return static_cast<Type>(m_flags & kTypeMask); }
+    // 本地时间形式的触发时间，仅供界面与持久化使用
+    QDateTime nextTrigger() const { return EpochMinute::toDateTime(m_nextTriggerMinute); }
+    // 调度比较使用的 UTC 纪元分钟；没有触发时间时为 EpochMinute::kInvalid
+    qint64 nextTriggerMinute() const { return m_nextTriggerMinute; }
+    bool hasNextTrigger() const { return m_nextTriggerMinute != EpochMinute::kInvalid; }
+    QString id() const { return m_id.toString(); }
+    // 调度器内部索引使用的定长键
+    const ReminderId &key() const { return m_id; }
+    bool completed() const { return (m_flags & kCompletedBit) != 0; }
+    Priority priority() const { return static_cast<Priority>((m_flags & kPriorityMask) >> kPriorityShift); }
 
     // Setters
-    void setName(const QString &name) { m_name = name; }
-    void setType(Type type) { m_type = type; }
-    void setNextTrigger(const QDateTime &trigger) { m_nextTrigger = trigger; }
-    void setId(const QString &id) { m_id = id; }
-    void setCompleted(bool completed) { m_completed = completed; }
-    void setPriority(Priority p) { m_priority = p; }
+    void setName(const QString &name) { m_name = PooledName(name); }
+    void setType(Type type) { m_flags = static_cast<quint8>((m_flags & ~kTypeMask) | static_cast<quint8>(type)); }
+    // 秒与毫秒会被截掉，触发时间始终精确到分钟
+    void setNextTrigger(const QDateTime &trigger) { m_nextTriggerMinute = EpochMinute::fromDateTime(trigger); }
+    void setNextTriggerMinute(qint64 minute) { m_nextTriggerMinute = minute; }
+    void setId(const QString &id) { m_id = ReminderId::fromString(id); }
+    void setKey(const ReminderId &key) { m_id = key; }
+    void setCompleted(bool completed) { m_flags = static_cast<quint8>(completed ? (m_flags | kCompletedBit) : (m_flags & ~kCompletedBit)); }
+    void setPriority(Priority p) { m_flags = static_cast<quint8>((m_flags & ~kPriorityMask) | (static_cast<quint8>(p) << kPriorityShift)); }
 
-    // JSON serialization
+    // JSON 只用于导入导出；数据库读写走 ReminderRowCodec
     QJsonObject toJson() const;
     static Reminder fromJson(const QJsonObject &json);
+    // 持久化的整数值转换，未知值分别按一次性/中优先级处理
+    static Type typeFromInt(int value);
+    static Priority priorityFromInt(int value);
+
+    // 与 other 相比发生变化的字段（不比较 ID）
+    Fields changedFields(const Reminder &other) const;
 
     // 相等运算符
     bool operator==(const Reminder &other) const {
-        return m_name == other.m_name &&
-               m_type == other.m_type &&
-               m_nextTrigger == other.m_nextTrigger &&
-               m_id == other.m_id &&
-               m_completed == other.m_completed &&
-               m_priority == other.m_priority;
+        return m_id == other.m_id &&
+               m_nextTriggerMinute == other.m_nextTriggerMinute &&
+               m_name == other.m_name &&
+               m_flags == other.m_flags;
     }
 
     bool operator!=(const Reminder &other) const {
@@ -56,14 +85,20 @@ public:
     }
 
 private:
-    QString m_name;
-    Type m_type = Type::Once;
-    QDateTime m_nextTrigger;
-    QString m_id;
-    bool m_completed = false;
-    Priority m_priority = Priority::Medium;
+    // m_flags: 低 2 位为类型，其后 2 位为优先级，第 4 位为完成状态
+    static constexpr quint8 kTypeMask = 0x03;
+    static constexpr quint8 kPriorityShift = 2;
+    static constexpr quint8 kPriorityMask = 0x0C;
+    static constexpr quint8 kCompletedBit = 0x10;
+
+    ReminderId m_id;
+    qint64 m_nextTriggerMinute = EpochMinute::kInvalid;
+    PooledName m_name;
+    quint8 m_flags = static_cast<quint8>(Priority::Medium) << kPriorityShift;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(Reminder::Fields)
 Q_DECLARE_METATYPE(Reminder)
+Q_DECLARE_METATYPE(Reminder::Fields)
 
 #endif // REMINDER_H
@@ -0,0 +1,116 @@
+#include "core/reminders/reminderid.h"
+#include <QAtomicInt>
+#include <QHash>
+#include <QReadWriteLock>
+
+namespace {
+// 派生旧格式 ID 的命名空间，固定不变以保证同一字符串总得到同一个键
+const QUuid kLegacyNamespace(QStringLiteral("{6f1c2a4e-8d3b-4b5f-9a70-2e4c8b1d5f36}"));
+
+struct LegacyEntry {
+    QAtomicInt ref;
+    QString text;
+};
+
+// 引用计数降到 0 只在写锁内发生并立即移除该项，因此持读锁时表中的项计数总大于 0
+struct LegacyIds {
+    QReadWriteLock lock;
+    QHash<QUuid, LegacyEntry *> entries;
+};
+
+LegacyIds &legacyIds()
+{
+    // 有意不析构：静态对象析构顺序不定，退出时可能仍有提醒 ID 在释放引用
+    static LegacyIds *ids = new LegacyIds;
+    return *ids;
+}
+}
+
+ReminderId ReminderId::fromString(const QString &text)
+{
+    if (text.isEmpty()) {
+        return ReminderId();
+    }
+
+    // 只有规范形式（小写、无花括号）才能无损还原，其余一律按旧格式处理
+    const QUuid uuid = QUuid::fromString(text);
+    if (!uuid.isNull() && !isLegacyKey(uuid) && uuid.toString(QUuid::WithoutBraces) == text) {
+        return ReminderId(uuid);
+    }
+
+    QUuid derived = QUuid::createUuidV5(kLegacyNamespace, text);
+    derived.data3 = static_cast<ushort>((derived.data3 & 0x0FFF) | 0x8000);
+    LegacyIds &legacy = legacyIds();
+    QWriteLocker locker(&legacy.lock);
+    LegacyEntry *&entry = legacy.entries[derived];
+    if (!entry) {
+        entry = new LegacyEntry;
+        entry->text = text;
+    }
+    entry->ref.ref();
+    return ReminderId(derived);
+}
+
+ReminderId ReminderId::fromUuid(const QUuid &uuid)
+{
+    if (isLegacyKey(uuid)) {
+        retainLegacy(uuid);
+    }
+    return ReminderId(uuid);
+}
+
+ReminderId ReminderId::createRandom()
+{
+    return ReminderId(QUuid::createUuid());
+}
+
+QString ReminderId::toString() const
+{
+    if (m_uuid.isNull()) {
+        return QString();
+    }
+    if (isLegacyKey(m_uuid)) {
+        LegacyIds &legacy = legacyIds();
+        QReadLocker locker(&legacy.lock);
+        LegacyEntry *entry = legacy.entries.value(m_uuid);
+        if (entry) {
+            return entry->text;
+        }
+    }
+    return m_uuid.toString(QUuid::WithoutBraces);
+}
+
+void ReminderId::retainLegacy(const QUuid &uuid)
+{
+    LegacyIds &legacy = legacyIds();
+    QReadLocker locker(&legacy.lock);
+    LegacyEntry *entry = legacy.entries.value(uuid);
+    if (entry) {
+        entry->ref.ref();
+    }
+}
+
+void ReminderId::releaseLegacy(const QUuid &uuid)
+{
+    LegacyIds &legacy = legacyIds();
+    {
+        // 不是最后一个引用时在读锁内递减即可
+        QReadLocker locker(&legacy.lock);
+        LegacyEntry *entry = legacy.entries.value(uuid);
+        if (!entry) {
+            return;
+        }
+        for (int count = entry->ref.loadRelaxed(); count > 1; count = entry->ref.loadRelaxed()) {
+            if (entry->ref.testAndSetOrdered(count, count - 1)) {
+                return;
+            }
+        }
+    }
+
+    QWriteLocker locker(&legacy.lock);
+    auto it = legacy.entries.find(uuid);
+    if (it != legacy.entries.end() && !it.value()->ref.deref()) {
+        delete it.value();
+        legacy.entries.erase(it);
+    }
+}
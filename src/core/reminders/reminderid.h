@@ -0,0 +1,70 @@
+#ifndef REMINDERID_H
+#define REMINDERID_H
+
+#include <QHashFunctions>
+#include <QString>
+#include <QUuid>
+#include <utility>
+
+// 提醒 ID 的紧凑表示：固定 16 字节的 128 位值，不占堆内存，比较与哈希都是定长操作。
+// 新建的提醒 ID 本就是 UUID 字符串，直接解析保存；旧数据中不是规范 UUID 形式的 ID
+// 按名称派生一个键（版本位标为 8，与普通 UUID 区分），原始字符串登记在进程内的映射表中，
+// 因此 toString() 总能还原出与数据库中一致的原始 ID。映射表的每一项带引用计数，
+// 持有该键的最后一个 ReminderId 析构时随之移除；普通 UUID 的复制与析构不涉及映射表。
+class ReminderId
+{
+public:
+    ReminderId() = default;
+    ReminderId(const ReminderId &other) : m_uuid(other.m_uuid)
+    {
+        if (isLegacyKey(m_uuid)) {
+            retainLegacy(m_uuid);
+        }
+    }
+    ReminderId(ReminderId &&other) noexcept : m_uuid(std::exchange(other.m_uuid, QUuid())) {}
+    ReminderId &operator=(const ReminderId &other)
+    {
+        ReminderId copy(other);
+        std::swap(m_uuid, copy.m_uuid);
+        return *this;
+    }
+    ReminderId &operator=(ReminderId &&other) noexcept
+    {
+        std::swap(m_uuid, other.m_uuid);
+        return *this;
+    }
+    ~ReminderId()
+    {
+        if (isLegacyKey(m_uuid)) {
+            releaseLegacy(m_uuid);
+        }
+    }
+
+    static ReminderId fromString(const QString &text);
+    static ReminderId fromUuid(const QUuid &uuid);
+    static ReminderId createRandom();
+
+    QString toString() const;
+    bool isNull() const { return m_uuid.isNull(); }
+    const QUuid &uuid() const { return m_uuid; }
+
+    bool operator==(const ReminderId &other) const { return m_uuid == other.m_uuid; }
+    bool operator!=(const ReminderId &other) const { return m_uuid != other.m_uuid; }
+
+private:
+    // 构造时已持有映射表中的一次引用（或不是旧格式键），不再重复计数
+    explicit ReminderId(const QUuid &uuid) : m_uuid(uuid) {}
+
+    static bool isLegacyKey(const QUuid &uuid) { return (uuid.data3 & 0xF000) == 0x8000; }
+    static void retainLegacy(const QUuid &uuid);
+    static void releaseLegacy(const QUuid &uuid);
+
+    QUuid m_uuid;
+};
+
+inline size_t qHash(const ReminderId &id, size_t seed = 0) noexcept
+{
+    return qHash(id.uuid(), seed);
+}
+
+#endif // REMINDERID_H
@@ -0,0 +1,363 @@
+#include "core/reminders/reminderjournal.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QThread>
+#include <QTimer>
+#include <utility>
+#include "core/config/configmanager.h"
+#include "core/logging/logger.h"
+
+ReminderJournal::ReminderJournal(int maxDelayMs)
+    : QObject(nullptr)
+    , m_thread(new QThread())
+    , m_commitTimer(new QTimer(this))
+    , m_migrationTimer(new QTimer(this))
+    , m_commitScheduled(false)
+    , m_maxDelayMs(qMax(0, maxDelayMs))
+    , m_retryDelayMs(0)
+    , m_shutdownOk(true)
+    , m_recoveryPending(false)
+{
+    m_commitTimer->setSingleShot(true);
+    connect(m_commitTimer, &QTimer::timeout, this, &ReminderJournal::commitPending);
+    m_migrationTimer->setSingleShot(true);
+    connect(m_migrationTimer, &QTimer::timeout, this, &ReminderJournal::migrateStep);
+    // 在调用方加载提醒之前重放上次关闭时没能写入的变更
+    recoverPending();
+
+    m_thread->setObjectName(QStringLiteral("ReminderJournal"));
+    moveToThread(m_thread);
+    m_thread->start();
+    LOG_INFO(QString("写后日志线程已启动，最大延迟 %1 ms").arg(m_maxDelayMs));
+}
+
+ReminderJournal::~ReminderJournal()
+{
+    shutdown();
+}
+
+void ReminderJournal::recordUpsert(const Reminder &reminder)
+{
+    recordChanges({reminder}, QStringList());
+}
+
+void ReminderJournal::recordDelete(const QString &id)
+{
+    recordChanges(QVector<Reminder>(), {id});
+}
+
+void ReminderJournal::recordChanges(const QVector<Reminder> &upserts, const QStringList &deletedIds)
+{
+    if (upserts.isEmpty() && deletedIds.isEmpty()) {
+        return;
+    }
+    // 先算出整批涉及的分片，再按序一次性加锁
+    QStringList upsertIds;
+    upsertIds.reserve(upserts.size());
+    quint32 mask = 0;
+    for (const Reminder &reminder : upserts) {
+        upsertIds.append(reminder.id());
+        mask |= 1u << shardIndex(upsertIds.last());
+    }
+    for (const QString &id : deletedIds) {
+        mask |= 1u << shardIndex(id);
+    }
+
+    lockShards(mask);
+    for (int i = 0; i < upserts.size(); ++i) {
+        PendingShard &shard = m_pending[shardIndex(upsertIds.at(i))];
+        shard.deletes.remove(upsertIds.at(i));
+        shard.upserts.insert(upsertIds.at(i), upserts.at(i));
+    }
+    for (const QString &id : deletedIds) {
+        PendingShard &shard = m_pending[shardIndex(id)];
+        shard.upserts.remove(id);
+        shard.deletes.insert(id);
+    }
+    unlockShards(mask);
+    scheduleCommit();
+}
+
+int ReminderJournal::maxDelay() const
+{
+    return m_maxDelayMs.load(std::memory_order_relaxed);
+}
+
+void ReminderJournal::setMaxDelay(int ms)
+{
+    m_maxDelayMs.store(qMax(0, ms), std::memory_order_relaxed);
+}
+
+int ReminderJournal::shardIndex(const QString &id)
+{
+    return static_cast<int>(qHash(id) & (kShardCount - 1));
+}
+
+void ReminderJournal::lockShards(quint32 mask)
+{
+    for (int i = 0; i < kShardCount; ++i) {
+        if (mask & (1u << i)) {
+            m_pending[i].mutex.lock();
+        }
+    }
+}
+
+void ReminderJournal::unlockShards(quint32 mask)
+{
+    for (int i = kShardCount - 1; i >= 0; --i) {
+        if (mask & (1u << i)) {
+            m_pending[i].mutex.unlock();
+        }
+    }
+}
+
+void ReminderJournal::scheduleCommit()
+{
+    // 一批内只安排一次提交，后续变更直接合并进待写集合
+    if (m_commitScheduled.exchange(true)) {
+        return;
+    }
+    QMetaObject::invokeMethod(this, &ReminderJournal::armCommitTimer, Qt::QueuedConnection);
+}
+
+void ReminderJournal::armCommitTimer()
+{
+    if (!m_commitTimer->isActive()) {
+        // 处于失败退避期间时按退避间隔提交
+        m_commitTimer->start(qMax(maxDelay(), m_retryDelayMs));
+    }
+}
+
+bool ReminderJournal::flush()
+{
+    if (!m_thread || !m_thread->isRunning() || QThread::currentThread() == thread()) {
+        return commitPending();
+    }
+    bool ok = false;
+    QMetaObject::invokeMethod(this, [this, &ok]() { ok = commitPending(); }, Qt::BlockingQueuedConnection);
+    return ok;
+}
+
+bool ReminderJournal::commitPending()
+{
+    m_commitTimer->stop();
+
+    constexpr quint32 kAllShards = (1u << kShardCount) - 1;
+    std::array<QHash<QString, Reminder>, kShardCount> upserts;
+    std::array<QSet<QString>, kShardCount> deletes;
+    bool empty = true;
+    // 同时持有全部分片锁再取走待写集合，保证 recordChanges 的一批不会被拆到两次提交中
+    lockShards(kAllShards);
+    m_commitScheduled.store(false);
+    for (int i = 0; i < kShardCount; ++i) {
+        upserts[i].swap(m_pending[i].upserts);
+        deletes[i].swap(m_pending[i].deletes);
+        empty = empty && upserts[i].isEmpty() && deletes[i].isEmpty();
+    }
+    unlockShards(kAllShards);
+    if (empty) {
+        return true;
+    }
+
+    QVector<Reminder> changed;
+    QStringList deletedIds;
+    for (int i = 0; i < kShardCount; ++i) {
+        for (const Reminder &reminder : std::as_const(upserts[i])) {
+            changed.append(reminder);
+        }
+        for (const QString &id : std::as_const(deletes[i])) {
+            deletedIds.append(id);
+        }
+    }
+    if (ConfigManager::instance().applyReminderChanges(changed, deletedIds)) {
+        if (m_retryDelayMs != 0) {
+            LOG_INFO("提醒批量写入已恢复");
+            m_retryDelayMs = 0;
+        }
+        if (m_recoveryPending.exchange(false)) {
+            QFile::remove(recoveryPath());
+        }
+        return true;
+    }
+
+    // 写入失败时放回待写集合，按指数退避重试，避免数据库持续不可用时空转刷日志
+    m_retryDelayMs = m_retryDelayMs == 0
+        ? qMax(kMinRetryDelayMs, maxDelay())
+        : qMin(m_retryDelayMs * 2, kMaxRetryDelayMs);
+    LOG_WARNING(QString("提醒批量写入失败，%1 ms 后重试").arg(m_retryDelayMs));
+    restorePending(upserts, deletes);
+    scheduleRetry();
+    return false;
+}
+
+void ReminderJournal::restorePending(const std::array<QHash<QString, Reminder>, kShardCount> &upserts,
+                                     const std::array<QSet<QString>, kShardCount> &deletes)
+{
+    constexpr quint32 kAllShards = (1u << kShardCount) - 1;
+    lockShards(kAllShards);
+    for (int i = 0; i < kShardCount; ++i) {
+        PendingShard &shard = m_pending[i];
+        for (auto it = upserts[i].constBegin(); it != upserts[i].constEnd(); ++it) {
+            if (!shard.upserts.contains(it.key()) && !shard.deletes.contains(it.key())) {
+                shard.upserts.insert(it.key(), it.value());
+            }
+        }
+        for (const QString &id : std::as_const(deletes[i])) {
+            if (!shard.upserts.contains(id)) {
+                shard.deletes.insert(id);
+            }
+        }
+    }
+    unlockShards(kAllShards);
+}
+
+void ReminderJournal::scheduleRetry()
+{
+    // 占住提交标记，退避期间新的变更不会把提交提前
+    m_commitScheduled.store(true);
+    if (QThread::currentThread() == thread()) {
+        m_commitTimer->start(m_retryDelayMs);
+    } else {
+        QMetaObject::invokeMethod(this, &ReminderJournal::armCommitTimer, Qt::QueuedConnection);
+    }
+}
+
+QString ReminderJournal::recoveryPath() const
+{
+    return ConfigManager::instance().databasePath() + QStringLiteral(".pending.json");
+}
+
+void ReminderJournal::recoverPending()
+{
+    QFile file(recoveryPath());
+    if (!file.exists()) {
+        return;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        LOG_ERROR(QString("无法读取恢复文件: %1").arg(file.fileName()));
+        return;
+    }
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    file.close();
+    QVector<Reminder> upserts;
+    for (const QJsonValue &value : root.value("upserts").toArray()) {
+        upserts.append(Reminder::fromJson(value.toObject()));
+    }
+    QStringList deletedIds;
+    for (const QJsonValue &value : root.value("deletes").toArray()) {
+        deletedIds.append(value.toString());
+    }
+    LOG_WARNING(QString("发现上次关闭时未写入的变更：更新 %1 个，删除 %2 个，重新写入")
+                    .arg(upserts.size()).arg(deletedIds.size()));
+    if (ConfigManager::instance().applyReminderChanges(upserts, deletedIds)) {
+        QFile::remove(file.fileName());
+        return;
+    }
+    // 仍然失败：文件保留到这些变更真正写入为止，同时交给正常的重试流程
+    m_recoveryPending = true;
+    recordChanges(upserts, deletedIds);
+}
+
+bool ReminderJournal::dumpPending()
+{
+    constexpr quint32 kAllShards = (1u << kShardCount) - 1;
+    QJsonArray upserts;
+    QJsonArray deletes;
+    lockShards(kAllShards);
+    for (const PendingShard &shard : m_pending) {
+        for (const Reminder &reminder : shard.upserts) {
+            upserts.append(reminder.toJson());
+        }
+        for (const QString &id : shard.deletes) {
+            deletes.append(id);
+        }
+    }
+    unlockShards(kAllShards);
+
+    QJsonObject root;
+    root["upserts"] = upserts;
+    root["deletes"] = deletes;
+    QSaveFile file(recoveryPath());
+    if (!file.open(QIODevice::WriteOnly)
+        || file.write(QJsonDocument(root).toJson(QJsonDocument::Compact)) < 0
+        || !file.commit()) {
+        LOG_ERROR(QString("写入恢复文件失败，%1 项变更丢失: %2")
+                      .arg(upserts.size() + deletes.size()).arg(file.fileName()));
+        return false;
+    }
+    LOG_ERROR(QString("关闭时提醒写入失败，%1 项变更已转存到 %2，下次启动时重新写入")
+                  .arg(upserts.size() + deletes.size()).arg(file.fileName()));
+    return true;
+}
+
+void ReminderJournal::startMigration()
+{
+    if (!ConfigManager::instance().legacyMigrationPending()) {
+        return;
+    }
+    LOG_INFO("开始后台迁移旧版提醒表");
+    QMetaObject::invokeMethod(m_migrationTimer, [this]() { m_migrationTimer->start(0); }, Qt::QueuedConnection);
+}
+
+void ReminderJournal::migrateStep()
+{
+    ConfigManager &config = ConfigManager::instance();
+    if (!config.legacyMigrationPending()) {
+        return;
+    }
+    // 先落盘待写变更，保证迁移批次不会覆盖更新的数据
+    commitPending();
+    const int migrated = config.migrateLegacyBatch(kMigrationBatch);
+    if (migrated < 0) {
+        LOG_WARNING(QString("提醒表迁移失败，%1 ms 后重试").arg(kMigrationRetryMs));
+        m_migrationTimer->start(kMigrationRetryMs);
+        return;
+    }
+    if (config.legacyMigrationPending()) {
+        m_migrationTimer->start(0);
+    }
+}
+
+bool ReminderJournal::shutdown()
+{
+    if (!m_thread) {
+        return m_shutdownOk;
+    }
+    // 关闭前在日志线程上做最后一次同步落盘
+    if (m_thread->isRunning()) {
+        if (QThread::currentThread() == m_thread) {
+            stopOnJournalThread();
+        } else {
+            QMetaObject::invokeMethod(this, &ReminderJournal::stopOnJournalThread,
+                                      Qt::BlockingQueuedConnection);
+        }
+        m_thread->quit();
+        m_thread->wait();
+    }
+    delete m_thread;
+    m_thread = nullptr;
+    LOG_INFO("写后日志线程已退出");
+    return m_shutdownOk;
+}
+
+void ReminderJournal::stopOnJournalThread()
+{
+    // 最后一次落盘失败时短暂退避再试，有限次数后把仍未写入的变更转存到恢复文件
+    bool ok = commitPending();
+    for (int attempt = 1; !ok && attempt < kShutdownAttempts; ++attempt) {
+        QThread::msleep(static_cast<unsigned long>(kShutdownRetryMs) << (attempt - 1));
+        ok = commitPending();
+    }
+    if (!ok) {
+        dumpPending();
+    }
+    m_shutdownOk = ok;
+    m_commitTimer->stop();
+    // 未完成的迁移留到下次启动继续
+    m_migrationTimer->stop();
+    ConfigManager::instance().releaseThreadConnection();
+    moveToThread(m_thread->thread());
+}
@@ -0,0 +1,98 @@
+#ifndef REMINDERJOURNAL_H
+#define REMINDERJOURNAL_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QMutex>
+#include <QStringList>
+#include <QVector>
+#include <array>
+#include <atomic>
+#include "core/reminders/reminder.h"
+
+class QThread;
+class QTimer;
+
+// 提醒的写后日志：在独立线程上用自己的数据库连接批量落盘。
+// 同一 id 的多次修改会合并为一次写入；每批在一个事务中提交，
+// 最长延迟 maxDelay 毫秒。flush() 会阻塞直到所有已记录的变更写入数据库。
+// 写入失败时变更留在待写集合中，按指数退避重试；关闭时重试有限次数，仍失败则把
+// 待写变更以 JSON 转存到数据库旁的恢复文件，下次构造时先重放该文件。
+// 待写集合按 ID 哈希分片，各有一把锁，多个线程同时记录变更时互不阻塞；
+// 一次 recordChanges 会同时持有它涉及的全部分片锁，因此整批仍落在同一事务中。
+// 旧版提醒表的后台迁移也在该线程上分批进行，与增量写入串行交替。
+class ReminderJournal : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ReminderJournal(int maxDelayMs = 50);
+    ~ReminderJournal();
+
+    // 以下接口可在任意线程调用
+    void recordUpsert(const Reminder &reminder);
+    void recordDelete(const QString &id);
+    // 一次加锁记录整批变更，保证它们落在同一个事务中
+    void recordChanges(const QVector<Reminder> &upserts, const QStringList &deletedIds);
+    // 返回 false 表示写入失败，变更仍在待写集合中等待重试
+    bool flush();
+    // 返回 false 表示最后一次落盘失败，未写入的变更已转存到恢复文件
+    bool shutdown();
+    // 若数据库中仍有旧版提醒表，开始在日志线程上分批迁移；应在启动加载完成后调用
+    void startMigration();
+
+    int maxDelay() const;
+    void setMaxDelay(int ms);
+
+private slots:
+    void armCommitTimer();
+    bool commitPending();
+    void migrateStep();
+    void stopOnJournalThread();
+
+private:
+    static constexpr int kShardCount = 16;
+    // 每批迁移的行数：一批一个事务，批间让出线程处理待写变更
+    static constexpr int kMigrationBatch = 500;
+    static constexpr int kMigrationRetryMs = 5000;
+    // 写入失败后的重试间隔从 kMinRetryDelayMs 起翻倍，最长 kMaxRetryDelayMs
+    static constexpr int kMinRetryDelayMs = 100;
+    static constexpr int kMaxRetryDelayMs = 30000;
+    // 关闭时最后一次落盘的尝试次数与首次重试间隔
+    static constexpr int kShutdownAttempts = 4;
+    static constexpr int kShutdownRetryMs = 100;
+
+    struct PendingShard {
+        QMutex mutex;
+        QHash<QString, Reminder> upserts;
+        QSet<QString> deletes;
+    };
+
+    static int shardIndex(const QString &id);
+    // 按下标升序加锁/解锁 mask 中的分片，固定顺序避免死锁
+    void lockShards(quint32 mask);
+    void unlockShards(quint32 mask);
+    void scheduleCommit();
+    void scheduleRetry();
+    // 把提交失败的一批放回待写集合，不覆盖期间产生的新变更
+    void restorePending(const std::array<QHash<QString, Reminder>, kShardCount> &upserts,
+                        const std::array<QSet<QString>, kShardCount> &deletes);
+    QString recoveryPath() const;
+    void recoverPending();
+    bool dumpPending();
+
+    QThread *m_thread;
+    QTimer *m_commitTimer;
+    QTimer *m_migrationTimer;
+    std::array<PendingShard, kShardCount> m_pending;
+    std::atomic<bool> m_commitScheduled;
+    std::atomic<int> m_maxDelayMs;
+    // 当前重试间隔，0 表示上次写入成功；只在日志线程上访问
+    int m_retryDelayMs;
+    bool m_shutdownOk;
+    // 恢复文件中的变更尚未写入数据库
+    std::atomic<bool> m_recoveryPending;
+};
+
+#endif // REMINDERJOURNAL_H
@@ -1,252 +1,937 @@
 #include "core/reminders/remindermanager.h"
-#include <QJsonArray>
-#include <QIcon>
 #include "core/logging/logger.h"
 #include <QDateTime>
 #include "core/config/configmanager.h"
 #include "core/reminders/reminder.h"
 #include <QTimer>
 #include <QMetaType>
-#include "core/calendar/workdaycalendar.h"
+#include <QThread>
+#include "core/time/clock.h"
+#include "core/reminders/triggerstats.h"
+#include "core/reminders/recurrence.h"
+#include <QtConcurrent/QtConcurrentMap>
+#include <limits>
+#include <utility>
 
 namespace {
 constexpr auto kDateTimeFormat = "yyyy-MM-dd HH:mm";
+// 到期时间很远时分段等待：既避免 QTimer 的 int 毫秒溢出，也限制了
+// 单调时钟在休眠期间停走时发现唤醒的最长延迟（仅在有待触发提醒时才会产生）
+constexpr qint64 kMaxTimerIntervalMs = 15 * 60 * 1000;
+// 墙上时间与单调时间的走时差超过该值即视为时间跳变（校时或休眠唤醒）
+constexpr qint64 kClockJumpThresholdMs = 30 * 1000;
+// 晚于到期时间超过该值（休眠、关机）才按补发策略处理
+constexpr qint64 kCatchUpGraceMs = 5 * 60 * 1000;
+}
 
-QDateTime toMinutePrecision(const QDateTime &dt)
+QVector<Reminder> ReminderSnapshot::toVector() const
 {
-    if (!dt.isValid()) {
-        return dt;
+    int total = 0;
+    for (const QVector<Reminder> &part : parts) {
+        total += part.size();
     }
-    QDateTime rounded(dt);
-    const QTime t = rounded.time();
-    rounded.setTime(QTime(t.hour(), t.minute()));
-    return rounded;
-}
+    QVector<Reminder> all;
+    all.reserve(total);
+    for (const QVector<Reminder> &part : parts) {
+        all += part;
+    }
+    return all;
 }
 
-ReminderManager::ReminderManager(QObject *parent)
+ReminderManager::ReminderManager(QObject *parent, HorizonPolicy horizon)
     : QObject(nullptr)
+    , m_thread(nullptr)
     , checkTimer(new QTimer(this))
     , isPaused(false)
+    , m_manualDispatch(false)
+    , m_burstThreshold(kDefaultBurstThreshold)
+    , m_rearmPending(false)
+    , m_wakeups(0)
+    , m_catchUpPolicy(Recurrence::CatchUpPolicy::FireOnce)
+    , m_backend(TriggerQueue::Backend::Heap)
+    , m_referenceWallMs(0)
+    , m_referenceMonotonicMs(0)
+    , m_clockJumps(0)
+    , m_horizonMinutes(0)
+    , m_horizonEnd(EpochMinute::kInvalid)
+    , m_journal(nullptr)
+    , m_snapshot(std::make_shared<const ReminderSnapshot>())
+    , m_generation(0)
+    , m_snapshotRequested(false)
+    , m_snapshotReady(false)
 {
     Q_UNUSED(parent);
     qRegisterMetaType<Reminder>("Reminder");
+    qRegisterMetaType<Reminder::Fields>("Reminder::Fields");
+    qRegisterMetaType<QVector<Reminder>>("QVector<Reminder>");
     LOG_INFO("ReminderManager 初始化");
+    m_backend = TriggerQueue::backendFromString(ConfigManager::instance().schedulerBackend());
+    const qint64 nowMinute = EpochMinute::fromMSecs(Clock::instance().nowMSecs());
+    for (Shard &shard : m_shards) {
+        shard.queue = TriggerQueue::create(m_backend, nowMinute);
+    }
+    LOG_INFO(QString("调度队列实现: %1，分片数 %2").arg(TriggerQueue::backendName(m_backend)).arg(kShardCount));
+    m_referenceWallMs = Clock::instance().nowMSecs();
+    m_referenceMonotonicMs = Clock::instance().monotonicMsecs();
+    m_catchUpPolicy = Recurrence::policyFromString(ConfigManager::instance().catchUpPolicy());
+    const int horizonHours = ConfigManager::instance().schedulerHorizonHours();
+    if (horizon == HorizonPolicy::FromConfig) {
+        m_horizonMinutes = static_cast<qint64>(horizonHours) * 60;
+    } else if (horizonHours > 0) {
+        LOG_INFO("界面程序不启用近期窗口模式，全部加载");
+    }
+    m_journal = new ReminderJournal(ConfigManager::instance().journalMaxDelay());
+    // 暂停状态可能由其他组件修改，通过设置变更通知同步，不再重复查询
+    connect(&ConfigManager::instance(), &ConfigManager::settingChanged, this, [this](const QString &key) {
+        if (key == ConfigManager::PAUSED_KEY) {
+            isPaused = ConfigManager::instance().isPaused();
+            requestRearm();
+        }
+    });
     setupTimer();
     loadReminders();
-    checkTimer->start();
+    // 加载读取的是迁移开始前的一致快照，之后旧表才开始在后台搬移
+    m_journal->startMigration();
+    startSchedulerThread();
 }
 
 ReminderManager::~ReminderManager()
 {
     LOG_INFO("ReminderManager 析构");
-    saveReminders();
+    shutdown();
+}
+
+void ReminderManager::startSchedulerThread()
+{
+    // 在构造线程中完成加载，界面可以立即读取；之后定时器和存储交给调度线程
+    m_thread = new QThread();
+    m_thread->setObjectName(QStringLiteral("ReminderScheduler"));
+    moveToThread(m_thread);
+    connect(m_thread, &QThread::started, this, &ReminderManager::rearmTimer);
+    m_thread->start();
+    LOG_INFO("调度线程已启动");
+}
+
+void ReminderManager::shutdown()
+{
+    if (!m_thread) {
+        return;
+    }
+    // 关闭握手：在调度线程上停止定时器，然后把对象交还给当前线程
+    if (m_thread->isRunning()) {
+        if (QThread::currentThread() == m_thread) {
+            stopOnSchedulerThread();
+        } else {
+            QMetaObject::invokeMethod(this, &ReminderManager::stopOnSchedulerThread,
+                                      Qt::BlockingQueuedConnection);
+        }
+        m_thread->quit();
+        m_thread->wait();
+    }
+    delete m_thread;
+    m_thread = nullptr;
+    LOG_INFO("调度线程已退出");
+
+    // 调度线程停止后不会再有新变更，最后把日志中的写入全部落盘
+    if (m_journal) {
+        if (!m_journal->shutdown()) {
+            LOG_ERROR("退出时提醒数据未能写入数据库，未写入的变更已转存到恢复文件");
+        }
+        delete m_journal;
+        m_journal = nullptr;
+    }
+    // 设置同样是异步写入的，退出前一并落盘
+    ConfigManager::instance().flushSettings();
+}
+
+void ReminderManager::stopOnSchedulerThread()
+{
+    checkTimer->stop();
+    ConfigManager::instance().releaseThreadConnection();
+    moveToThread(m_thread->thread());
+}
+
+int ReminderManager::shardIndex(const ReminderId &id)
+{
+    return static_cast<int>(qHash(id) & (kShardCount - 1));
+}
+
+void ReminderManager::requestRearm()
+{
+    // 定时器只能在所属线程上操作；多个线程同时修改时只投递一次
+    if (m_rearmPending.exchange(true)) {
+        return;
+    }
+    QMetaObject::invokeMethod(this, &ReminderManager::rearmTimer, Qt::QueuedConnection);
 }
 
 void ReminderManager::setupTimer()
 {
     LOG_INFO("设置定时器");
     connect(checkTimer, &QTimer::timeout, this, &ReminderManager::checkReminders);
-    checkTimer->setInterval(5000); // 每5秒检查一次
+    // 不再轮询：只为最早到期的提醒设置一次性定时器。
+    // 粗粒度定时器可能提前数个百分点触发，造成一次空唤醒后再重新计时，因此使用精确定时器
+    checkTimer->setSingleShot(true);
+    checkTimer->setTimerType(Qt::PreciseTimer);
+}
+
+void ReminderManager::rearmTimer()
+{
+    m_rearmPending.store(false);
+    const qint64 nowMs = Clock::instance().nowMSecs();
+    detectClockJump(nowMs);
+    const qint64 nextDue = nextDueMinute();
+    // 暂停或没有待触发的提醒时不设定时器，空闲期间零唤醒
+    if (isPaused || m_manualDispatch || nextDue == EpochMinute::kInvalid) {
+        checkTimer->stop();
+        return;
+    }
+    const qint64 delay = qBound<qint64>(0, EpochMinute::toMSecs(nextDue) - nowMs, kMaxTimerIntervalMs);
+    checkTimer->start(static_cast<int>(delay));
+    LOG_DEBUG(QString("下次检查时间: %1").arg(EpochMinute::toDateTime(nextDue).toString(kDateTimeFormat)));
+}
+
+qint64 ReminderManager::nextDueMinute() const
+{
+    qint64 earliest = EpochMinute::kInvalid;
+    for (const Shard &shard : m_shards) {
+        QMutexLocker locker(&shard.mutex);
+        const qint64 due = shard.queue->nextDue();
+        if (due != EpochMinute::kInvalid && (earliest == EpochMinute::kInvalid || due < earliest)) {
+            earliest = due;
+        }
+    }
+    // 窗口模式下窗口需要滑动的时刻也算作一次到期，内存中没有提醒时同样会按时调入后续提醒
+    if (m_horizonMinutes > 0) {
+        const qint64 slide = m_horizonEnd.load() - m_horizonMinutes + horizonStep();
+        if (earliest == EpochMinute::kInvalid || slide < earliest) {
+            earliest = slide;
+        }
+    }
+    return earliest;
+}
+
+qint64 ReminderManager::horizonMinutes() const
+{
+    return m_horizonMinutes;
+}
+
+qint64 ReminderManager::horizonStep() const
+{
+    return qMax<qint64>(1, m_horizonMinutes / kHorizonSteps);
+}
+
+bool ReminderManager::beyondHorizon(const Reminder &reminder) const
+{
+    return m_horizonMinutes > 0
+        && (reminder.completed() || !reminder.hasNextTrigger()
+            || reminder.nextTriggerMinute() >= m_horizonEnd.load());
+}
+
+void ReminderManager::slideHorizon(qint64 nowMinute)
+{
+    if (m_horizonMinutes <= 0) {
+        return;
+    }
+    const qint64 from = m_horizonEnd.load();
+    const qint64 to = nowMinute + m_horizonMinutes;
+    if (to < from + horizonStep()) {
+        return;
+    }
+    // 先推进窗口上界，再依次获取各分片锁作为屏障：按旧上界判定为窗口外、只写入日志的
+    // 添加或修改此时都已进入写后日志，落盘后范围查询一定能看到它们
+    m_horizonEnd = to;
+    for (Shard &shard : m_shards) {
+        QMutexLocker locker(&shard.mutex);
+    }
+    m_journal->flush();
+    const QVector<Reminder> rows = ConfigManager::instance().getRemindersDueBetween(from, to);
+
+    std::array<QVector<Reminder>, kShardCount> groups;
+    for (const Reminder &reminder : rows) {
+        groups[shardIndex(reminder.key())].append(reminder);
+    }
+    quint32 changedShards = 0;
+    QVector<Reminder> added;
+    for (int i = 0; i < kShardCount; ++i) {
+        if (groups[i].isEmpty()) {
+            continue;
+        }
+        Shard &shard = m_shards[i];
+        QMutexLocker locker(&shard.mutex);
+        for (const Reminder &reminder : std::as_const(groups[i])) {
+            // 刚添加或修改进窗口的提醒已在内存中，以内存中的为准
+            if (!shard.store.insert(reminder)) {
+                continue;
+            }
+            scheduleReminder(shard, reminder);
+            added.append(reminder);
+            changedShards |= 1u << i;
+        }
+    }
+    LOG_DEBUG(QString("近期窗口滑动至 %1，调入 %2 个提醒")
+                  .arg(EpochMinute::toDateTime(to).toString(kDateTimeFormat))
+                  .arg(added.size()));
+    if (changedShards == 0) {
+        return;
+    }
+    publishSnapshot(changedShards);
+    emitAdded(added);
+}
+
+QSet<ReminderId> ReminderManager::storedOutsideMemory(const QVector<ReminderId> &keys)
+{
+    QSet<ReminderId> stored;
+    if (m_horizonMinutes <= 0) {
+        return stored;
+    }
+    QStringList candidates;
+    for (const ReminderId &key : keys) {
+        const Shard &shard = m_shards[shardIndex(key)];
+        QMutexLocker locker(&shard.mutex);
+        if (!shard.store.contains(key)) {
+            candidates.append(key.toString());
+        }
+    }
+    if (candidates.isEmpty()) {
+        return stored;
+    }
+    // 先让写后日志落盘，查询才能看到刚移出内存或刚删除的提醒
+    m_journal->flush();
+    for (const QString &id : ConfigManager::instance().existingReminderIds(candidates)) {
+        stored.insert(ReminderId::fromString(id));
+    }
+    return stored;
+}
+
+bool ReminderManager::detectClockJump(qint64 nowMs)
+{
+    const qint64 monotonicMs = Clock::instance().monotonicMsecs();
+    const qint64 drift = (nowMs - m_referenceWallMs) - (monotonicMs - m_referenceMonotonicMs);
+    m_referenceWallMs = nowMs;
+    m_referenceMonotonicMs = monotonicMs;
+    if (qAbs(drift) <= kClockJumpThresholdMs) {
+        return false;
+    }
+    m_clockJumps.fetch_add(1, std::memory_order_relaxed);
+    LOG_WARNING(QString("检测到系统时间跳变 %1 秒（校时或休眠唤醒），重建调度队列").arg(drift / 1000));
+    rebuildQueues(EpochMinute::fromMSecs(nowMs));
+    return true;
+}
+
+void ReminderManager::rebuildQueues(qint64 nowMinute)
+{
+    // 时间轮等实现以游标为基准分层，时间回拨后必须按新的当前时间整体重建；
+    // 逐个分片加锁重建，其他分片上的修改不受影响
+    for (Shard &shard : m_shards) {
+        QMutexLocker locker(&shard.mutex);
+        shard.queue = TriggerQueue::create(m_backend, nowMinute);
+        for (const Reminder &reminder : shard.store.items()) {
+            scheduleReminder(shard, reminder);
+        }
+    }
+}
+
+quint64 ReminderManager::clockJumpCount() const
+{
+    return m_clockJumps.load(std::memory_order_relaxed);
+}
+
+void ReminderManager::scheduleReminder(Shard &shard, const Reminder &reminder)
+{
+    if (reminder.completed() || !reminder.hasNextTrigger()) {
+        shard.queue->cancel(reminder.key());
+        return;
+    }
+    shard.queue->schedule(reminder.key(), reminder.nextTriggerMinute());
 }
 
 void ReminderManager::loadReminders()
 {
+    // 在构造函数中调用，此时调度线程尚未启动，不存在并发访问
     LOG_INFO("开始加载提醒");
-    QJsonArray reminders = ConfigManager::instance().getReminders();
-    m_reminders.clear();
-    for (const QJsonValue &value : reminders) {
-        if (value.isObject()) {
-            Reminder reminder = Reminder::fromJson(value.toObject());
-            reminder.setNextTrigger(toMinutePrecision(reminder.nextTrigger()));
-            m_reminders.append(reminder);
+    ConfigManager &config = ConfigManager::instance();
+    if (m_horizonMinutes > 0 && config.legacyMigrationPending()) {
+        // 旧表中的触发时间是文本，无法按范围查询
+        LOG_WARNING("旧版提醒表尚未迁移完成，本次运行不启用近期窗口");
+        m_horizonMinutes = 0;
+    }
+    QVector<Reminder> reminders;
+    if (m_horizonMinutes > 0) {
+        m_horizonEnd = EpochMinute::fromMSecs(Clock::instance().nowMSecs()) + m_horizonMinutes;
+        // 关机期间错过的提醒同样调入，交给补发策略处理
+        reminders = config.getRemindersDueBetween(std::numeric_limits<qint64>::min(), m_horizonEnd.load());
+        LOG_INFO(QString("近期窗口 %1 小时，只加载窗口内到期的提醒").arg(m_horizonMinutes / 60));
+    } else {
+        reminders = config.getReminders();
+    }
+    for (Shard &shard : m_shards) {
+        shard.store.clear();
+        shard.store.reserve(reminders.size() / kShardCount + 1);
+        shard.queue->clear();
+    }
+    int loaded = 0;
+    for (const Reminder &reminder : reminders) {
+        Shard &shard = m_shards[shardIndex(reminder.key())];
+        if (shard.store.insert(reminder)) {
+            scheduleReminder(shard, reminder);
+            ++loaded;
         }
     }
     
     // 同步暂停状态
-    isPaused = ConfigManager::instance().isPaused();
+    isPaused = config.isPaused();
     
-    LOG_INFO(QString("共加载 %1 个提醒").arg(m_reminders.size()));
+    LOG_INFO(QString("共加载 %1 个提醒").arg(loaded));
 }
 
 void ReminderManager::addReminder(const Reminder &reminder)
 {
-    QMutexLocker locker(&mutex);
-    for (const Reminder &r : m_reminders) {
-        if (r.id() == reminder.id()) {
-            LOG_WARNING(QString("尝试添加重复的提醒 ID: %1").arg(reminder.id()));
-            return;
+    addReminders({reminder});
+}
+
+void ReminderManager::updateReminder(const Reminder &reminder)
+{
+    updateReminders({reminder});
+}
+
+void ReminderManager::deleteReminder(const Reminder &reminder)
+{
+    deleteReminders({reminder.id()});
+}
+
+void ReminderManager::addReminders(const QVector<Reminder> &reminders)
+{
+    // 先按分片分组，每个分片只加锁一次；写后日志的记录在分片锁内完成，
+    // 保证同一提醒的多次修改按存储中的顺序落盘
+    std::array<QVector<Reminder>, kShardCount> groups;
+    QVector<ReminderId> keys;
+    keys.reserve(reminders.size());
+    for (const Reminder &reminder : reminders) {
+        groups[shardIndex(reminder.key())].append(reminder);
+        keys.append(reminder.key());
+    }
+    // 窗口模式下内存中没有的提醒仍可能已在数据库里，查重要连同数据库一起查
+    const QSet<ReminderId> stored = storedOutsideMemory(keys);
+    quint32 changedShards = 0;
+    int saved = 0;
+    QVector<Reminder> added;
+    for (int i = 0; i < kShardCount; ++i) {
+        if (groups[i].isEmpty()) {
+            continue;
         }
+        Shard &shard = m_shards[i];
+        QVector<Reminder> persisted;
+        QVector<Reminder> inserted;
+        persisted.reserve(groups[i].size());
+        inserted.reserve(groups[i].size());
+        QMutexLocker locker(&shard.mutex);
+        for (const Reminder &reminder : std::as_const(groups[i])) {
+            if (stored.contains(reminder.key()) || shard.store.contains(reminder.key())) {
+                LOG_WARNING(QString("尝试添加重复的提醒 ID: %1").arg(reminder.id()));
+                continue;
+            }
+            persisted.append(reminder);
+            // 窗口之外的提醒只写入数据库，窗口滑到时再调入
+            if (beyondHorizon(reminder)) {
+                continue;
+            }
+            shard.store.insert(reminder);
+            scheduleReminder(shard, reminder);
+            inserted.append(reminder);
+        }
+        if (!persisted.isEmpty()) {
+            m_journal->recordChanges(persisted, QStringList());
+            saved += persisted.size();
+        }
+        if (!inserted.isEmpty()) {
+            changedShards |= 1u << i;
+            added += inserted;
+        }
+    }
+    if (saved == 0) {
+        return;
+    }
+    LOG_INFO(QString("添加 %1 个提醒").arg(saved));
+    if (changedShards == 0) {
+        return;
     }
-    Reminder normalized = reminder;
-    normalized.setNextTrigger(toMinutePrecision(reminder.nextTrigger()));
-    m_reminders.append(normalized);
-    saveReminders();
+    publishSnapshot(changedShards);
+    requestRearm();
+    emitAdded(added);
 }
 
-void ReminderManager::updateReminder(const Reminder &reminder)
+void ReminderManager::updateReminders(const QVector<Reminder> &reminders)
 {
-    QMutexLocker locker(&mutex);
-    for (int i = 0; i < m_reminders.size(); ++i) {
-        if (m_reminders[i].id() == reminder.id()) {
-            Reminder normalized = reminder;
-            normalized.setNextTrigger(toMinutePrecision(reminder.nextTrigger()));
-            m_reminders[i] = normalized;
-            saveReminders();
-            break;
+    std::array<QVector<Reminder>, kShardCount> groups;
+    QVector<ReminderId> keys;
+    keys.reserve(reminders.size());
+    for (const Reminder &reminder : reminders) {
+        groups[shardIndex(reminder.key())].append(reminder);
+        keys.append(reminder.key());
+    }
+    // 窗口模式下不在内存中的提醒只要数据库里有，同样接受修改
+    const QSet<ReminderId> stored = storedOutsideMemory(keys);
+    quint32 changedShards = 0;
+    int saved = 0;
+    QVector<Reminder> added;
+    QVector<Update> updates;
+    for (int i = 0; i < kShardCount; ++i) {
+        if (groups[i].isEmpty()) {
+            continue;
+        }
+        Shard &shard = m_shards[i];
+        QVector<Reminder> changed;
+        changed.reserve(groups[i].size());
+        QMutexLocker locker(&shard.mutex);
+        for (const Reminder &reminder : std::as_const(groups[i])) {
+            Reminder *current = shard.store.find(reminder.key());
+            if (!current) {
+                if (!stored.contains(reminder.key())) {
+                    continue;
+                }
+                // 改到窗口之内的调入内存，其余只写入数据库
+                changed.append(reminder);
+                if (!beyondHorizon(reminder)) {
+                    shard.store.insert(reminder);
+                    scheduleReminder(shard, reminder);
+                    added.append(reminder);
+                    changedShards |= 1u << i;
+                }
+                continue;
+            }
+            // 内容没有变化的更新不落盘也不通知
+            const Reminder::Fields fields = current->changedFields(reminder);
+            if (!fields) {
+                continue;
+            }
+            changed.append(reminder);
+            changedShards |= 1u << i;
+            // 改到窗口之外或已完成的提醒写入数据库后静默移出内存
+            if (beyondHorizon(reminder)) {
+                shard.queue->cancel(reminder.key());
+                shard.store.remove(reminder.key());
+                continue;
+            }
+            *current = reminder;
+            scheduleReminder(shard, reminder);
+            updates.append({reminder, fields});
         }
+        if (!changed.isEmpty()) {
+            m_journal->recordChanges(changed, QStringList());
+            saved += changed.size();
+        }
+    }
+    if (saved == 0) {
+        return;
     }
+    LOG_INFO(QString("更新 %1 个提醒").arg(saved));
+    if (changedShards == 0) {
+        return;
+    }
+    publishSnapshot(changedShards);
+    requestRearm();
+    emitAdded(added);
+    emitUpdates(updates);
 }
 
-void ReminderManager::deleteReminder(const Reminder &reminder)
+void ReminderManager::deleteReminders(const QStringList &ids)
 {
-    QMutexLocker locker(&mutex);
-    for (int i = 0; i < m_reminders.size(); ++i) {
-        if (m_reminders[i].id() == reminder.id()) {
-            m_reminders.removeAt(i);
-            saveReminders();
-            break;
+    std::array<QVector<ReminderId>, kShardCount> groups;
+    for (const QString &id : ids) {
+        const ReminderId key = ReminderId::fromString(id);
+        groups[shardIndex(key)].append(key);
+    }
+    quint32 changedShards = 0;
+    int deleted = 0;
+    QStringList removed;
+    for (int i = 0; i < kShardCount; ++i) {
+        if (groups[i].isEmpty()) {
+            continue;
+        }
+        Shard &shard = m_shards[i];
+        QStringList removedIds;
+        QStringList deletedIds;
+        QMutexLocker locker(&shard.mutex);
+        for (const ReminderId &key : std::as_const(groups[i])) {
+            if (!shard.store.remove(key)) {
+                // 窗口模式下不在内存中的提醒仍可能在数据库里，删除照样写入（不存在时是空操作）
+                if (m_horizonMinutes > 0) {
+                    deletedIds.append(key.toString());
+                }
+                continue;
+            }
+            shard.queue->cancel(key);
+            removedIds.append(key.toString());
+        }
+        deletedIds += removedIds;
+        if (!deletedIds.isEmpty()) {
+            m_journal->recordChanges(QVector<Reminder>(), deletedIds);
+            deleted += deletedIds.size();
+        }
+        if (!removedIds.isEmpty()) {
+            changedShards |= 1u << i;
+            removed += removedIds;
         }
     }
+    if (deleted == 0) {
+        return;
+    }
+    LOG_INFO(QString("删除 %1 个提醒").arg(deleted));
+    if (changedShards == 0) {
+        return;
+    }
+    publishSnapshot(changedShards);
+    requestRearm();
+    emitRemoved(removed);
 }
 
 void ReminderManager::pauseAll()
 {
     LOG_INFO("暂停所有提醒");
-    QMutexLocker locker(&mutex);
     isPaused = true;
     ConfigManager::instance().setPaused(true);
+    requestRearm();
 }
 
 void ReminderManager::resumeAll()
 {
     LOG_INFO("恢复所有提醒");
-    QMutexLocker locker(&mutex);
     isPaused = false;
     ConfigManager::instance().setPaused(false);
+    requestRearm();
 }
 
 QVector<Reminder> ReminderManager::getReminders() const
 {
-    QMutexLocker locker(&mutex);
-    return m_reminders;
+    // 各分片的数组隐式共享，这里只做一次拼接
+    return snapshot()->toVector();
+}
+
+ReminderSnapshotPtr ReminderManager::snapshot() const
+{
+    if (!m_snapshotReady.load(std::memory_order_acquire)) {
+        // 第一次读取时构建完整快照，此后由写入方在每次变更后发布
+        QMutexLocker locker(&m_snapshotMutex);
+        if (!m_snapshotReady.load(std::memory_order_relaxed)) {
+            // 先置位 requested：构建期间修改了已复制分片的写入方会随后补发
+            m_snapshotRequested.store(true);
+            auto initial = std::make_shared<ReminderSnapshot>();
+            initial->parts.resize(kShardCount);
+            for (int i = 0; i < kShardCount; ++i) {
+                QMutexLocker shardLocker(&m_shards[i].mutex);
+                initial->parts[i] = m_shards[i].store.items();
+            }
+            initial->generation = ++m_generation;
+            std::atomic_store(&m_snapshot, ReminderSnapshotPtr(std::move(initial)));
+            m_snapshotReady.store(true, std::memory_order_release);
+        }
+    }
+    return std::atomic_load(&m_snapshot);
+}
+
+quint64 ReminderManager::generation() const
+{
+    return snapshot()->generation;
+}
+
+void ReminderManager::publishSnapshot(quint32 changedShards) const
+{
+    if (!m_snapshotRequested.load()) {
+        return;
+    }
+    // 以当前快照为底，只替换发生变化的分片；其余分片继续共享原数组。
+    // 新快照与分片存储共享数组，存储下次修改时才复制该分片（写入方承担复制开销）
+    QMutexLocker locker(&m_snapshotMutex);
+    auto next = std::make_shared<ReminderSnapshot>(*std::atomic_load(&m_snapshot));
+    for (int i = 0; i < kShardCount; ++i) {
+        if (changedShards & (1u << i)) {
+            QMutexLocker shardLocker(&m_shards[i].mutex);
+            next->parts[i] = m_shards[i].store.items();
+        }
+    }
+    next->generation = ++m_generation;
+    std::atomic_store(&m_snapshot, ReminderSnapshotPtr(std::move(next)));
 }
 
-void ReminderManager::saveReminders()
+bool ReminderManager::saveReminders()
 {
+    // 变更已记录在写后日志中，这里只需同步落盘
     LOG_INFO("保存提醒数据");
-    QMutexLocker locker(&mutex);
-    QJsonArray array;
-    for (const Reminder &reminder : m_reminders) {
-        array.append(reminder.toJson());
+    if (!m_journal->flush()) {
+        LOG_ERROR("保存提醒数据失败，变更保留在写后日志中等待重试");
+        return false;
     }
-    ConfigManager::instance().setReminders(array);
+    return true;
+}
+
+void ReminderManager::setManualDispatch(bool manual)
+{
+    m_manualDispatch = manual;
+    requestRearm();
+}
+
+QDateTime ReminderManager::nextDueTime() const
+{
+    return EpochMinute::toDateTime(nextDueMinute());
+}
+
+void ReminderManager::processDue()
+{
+    // 在调度线程上执行与定时器到期时完全相同的检查流程，返回时已处理完毕
+    if (!m_thread || !m_thread->isRunning() || QThread::currentThread() == thread()) {
+        checkReminders();
+        return;
+    }
+    QMetaObject::invokeMethod(this, &ReminderManager::checkReminders, Qt::BlockingQueuedConnection);
+}
+
+void ReminderManager::setBurstThreshold(int threshold)
+{
+    m_burstThreshold = qMax(1, threshold);
+}
+
+quint64 ReminderManager::wakeupCount() const
+{
+    return m_wakeups.load(std::memory_order_relaxed);
 }
 
 void ReminderManager::checkReminders()
 {
-    QMutexLocker locker(&mutex);
+    m_wakeups.fetch_add(1, std::memory_order_relaxed);
     if (isPaused) {
         return;
     }
 
-    QDateTime currentTime = QDateTime::currentDateTime();
-    LOG_DEBUG(QString("检查提醒，当前时间: %1").arg(currentTime.toString(kDateTimeFormat)));
-    
-    for (auto it = m_reminders.begin(); it != m_reminders.end(); ++it) {
-        Reminder &reminder = *it;
-        QString id = reminder.id();
-        QDateTime nextTrigger = reminder.nextTrigger();
-        
-        LOG_DEBUG(QString("检查提醒 [%1]: 下次触发时间 = %2")
-            .arg(id)
-            .arg(nextTrigger.toString(kDateTimeFormat)));
-            
-        if (shouldTrigger(reminder)) {
-            LOG_INFO(QString("触发提醒 [%1]").arg(id));
-            emit reminderTriggered(reminder);
-            calculateNextTrigger(reminder);
-            saveReminders();
+    // 每轮只读一次当前时间；比较都在 UTC 纪元分钟上进行，
+    // 只有真正触发、需要按本地日期推算下一次时才构造 QDateTime
+    const qint64 nowMs = Clock::instance().nowMSecs();
+    const qint64 nowMinute = EpochMinute::fromMSecs(nowMs);
+    // 发生跳变时先整体重建队列，随后所有已过期的提醒在本轮一次性处理
+    const bool clockJumped = detectClockJump(nowMs);
+    // 窗口模式下先调入新进入窗口（或因时间跳变已过期）的提醒，本轮一并处理
+    slideHorizon(nowMinute);
+
+    // 墙上时间只在本轮开始读一次，之后的耗时用单调时钟补上
+    const qint64 passStartUs = TriggerStats::monotonicMicros();
+
+    // 第一步：逐个分片取出到期集合，锁内只做复制
+    QVector<DueItem> due;
+    for (int i = 0; i < kShardCount; ++i) {
+        Shard &shard = m_shards[i];
+        QMutexLocker locker(&shard.mutex);
+        // 只处理队列中已到期的提醒，无需遍历全部
+        const QVector<ReminderId> dueIds = shard.queue->takeDue(nowMinute);
+        for (const ReminderId &id : dueIds) {
+            const Reminder *found = shard.store.find(id);
+            if (!found) {
+                continue;
+            }
+            if (!shouldTrigger(*found, nowMinute)) {
+                scheduleReminder(shard, *found);
+                continue;
+            }
+            DueItem item;
+            item.original = *found;
+            item.reminder = *found;
+            item.shard = i;
+            due.append(item);
         }
     }
+    if (due.isEmpty()) {
+        rearmTimer();
+        return;
+    }
+
+    // 第二步：在锁外推算下一次触发时间；同一分钟大量到期时分发到线程池并行计算
+    const QDateTime localNow = QDateTime::fromMSecsSinceEpoch(nowMs);
+    const bool burst = due.size() >= m_burstThreshold.load(std::memory_order_relaxed);
+    if (burst) {
+        LOG_INFO(QString("同一轮到期 %1 个提醒，并行推算下次触发时间").arg(due.size()));
+        QtConcurrent::blockingMap(due, [this, nowMs, &localNow](DueItem &item) {
+            advanceDueItem(item, nowMs, localNow, false);
+        });
+    } else {
+        for (DueItem &item : due) {
+            advanceDueItem(item, nowMs, localNow, true);
+        }
+    }
+
+    // 第三步：按分片写回。到期集合按分片顺序收集，每个分片只加锁一次；
+    // 推算期间被界面修改或删除的提醒以界面的版本为准（修改时已重新入队）
+    quint32 changedShards = 0;
+    QVector<Reminder> triggered;
+    QVector<Update> updates;
+    int evicted = 0;
+    updates.reserve(due.size());
+    for (int begin = 0; begin < due.size();) {
+        const int index = due.at(begin).shard;
+        int end = begin;
+        while (end < due.size() && due.at(end).shard == index) {
+            ++end;
+        }
+        Shard &shard = m_shards[index];
+        QVector<Reminder> changed;
+        changed.reserve(end - begin);
+        QMutexLocker locker(&shard.mutex);
+        for (int k = begin; k < end; ++k) {
+            const DueItem &item = due.at(k);
+            Reminder *found = shard.store.find(item.original.key());
+            if (!found || *found != item.original) {
+                continue;
+            }
+            *found = item.reminder;
+            changed.append(*found);
+            if (item.notify && item.missedCount == 0) {
+                triggered.append(item.original);
+            }
+            // 窗口模式下推进到窗口之外或已完成的提醒交给写后日志落盘后静默移出内存
+            if (beyondHorizon(*found)) {
+                shard.queue->cancel(found->key());
+                shard.store.remove(item.original.key());
+                ++evicted;
+                continue;
+            }
+            scheduleReminder(shard, *found);
+            updates.append({*found, item.original.changedFields(*found)});
+        }
+        if (!changed.isEmpty()) {
+            // 分片内的变更作为一批交给写后日志，整轮在同一个事务中落盘
+            m_journal->recordChanges(changed, QStringList());
+            changedShards |= 1u << index;
+        }
+        begin = end;
+    }
+
+    // 先发布快照再发通知，界面收到触发信号时读到的已是推进后的状态
+    if (changedShards != 0) {
+        publishSnapshot(changedShards);
+    }
+    emitTriggered(due, triggered, passStartUs);
+    // 触发通知优先发出，列表更新随后；跳过或汇总补发的提醒同样在这里刷新
+    emitUpdates(updates);
+    if (clockJumped || burst) {
+        LOG_INFO(QString("本轮批量处理 %1 个到期提醒，触发 %2 个").arg(updates.size() + evicted).arg(triggered.size()));
+    }
+    rearmTimer();
 }
 
-void ReminderManager::calculateNextTrigger(Reminder &reminder)
+void ReminderManager::advanceDueItem(DueItem &item, qint64 nowMs, const QDateTime &localNow, bool logEach) const
 {
-    QDateTime currentTime = QDateTime::currentDateTime();
-    Reminder::Type type = reminder.type();
-    QDateTime nextTrigger;
+    // 可能在线程池中并行执行：只读写 item 本身与只读的成员
+    Reminder &reminder = item.reminder;
+    const Recurrence::Advance advance = Recurrence::advance(reminder, localNow);
+    const qint64 lateMs = nowMs - EpochMinute::toMSecs(reminder.nextTriggerMinute());
+    const bool catchingUp = reminder.type() != Reminder::Type::Once
+        && (advance.occurrences > 1 || lateMs > kCatchUpGraceMs);
+    if (!catchingUp) {
+        if (logEach) {
+            LOG_INFO(QString("触发提醒 [%1]").arg(reminder.id()));
+        }
+        item.notify = true;
+        item.lateMs = lateMs;
+    } else {
+        // 每个提醒每次补发至多一条通知，避免关机多日后连续弹窗
+        LOG_INFO(QString("提醒 [%1] 错过 %2 次，补发策略: %3")
+                     .arg(reminder.id())
+                     .arg(advance.occurrences)
+                     .arg(Recurrence::policyName(m_catchUpPolicy)));
+        switch (m_catchUpPolicy) {
+        case Recurrence::CatchUpPolicy::FireAll:
+            item.notify = true;
+            item.missedCount = advance.occurrences;
+            break;
+        case Recurrence::CatchUpPolicy::Skip:
+            break;
+        case Recurrence::CatchUpPolicy::FireOnce:
+        default:
+            item.notify = true;
+            break;
+        }
+    }
+    calculateNextTrigger(reminder, advance, logEach);
+}
+
+void ReminderManager::emitTriggered(const QVector<DueItem> &due, const QVector<Reminder> &triggered,
+                                    qint64 passStartUs)
+{
+    for (const DueItem &item : due) {
+        if (item.notify && item.missedCount > 0) {
+            emit reminderMissed(item.original, item.missedCount);
+        }
+    }
+    if (triggered.isEmpty()) {
+        return;
+    }
+    // 同一轮的触发合并为一次信号，迟到时间按每个提醒分别计入
+    const qint64 dispatchedAtUs = TriggerStats::monotonicMicros();
+    for (const DueItem &item : due) {
+        if (item.notify && item.missedCount == 0 && item.lateMs >= 0) {
+            TriggerStats::instance().recordTriggerDelay(item.lateMs * 1000 + (dispatchedAtUs - passStartUs));
+        }
+    }
+    emit remindersTriggered(triggered, dispatchedAtUs);
+}
 
-    if (type == Reminder::Type::Once) {
+void ReminderManager::emitAdded(const QVector<Reminder> &added)
+{
+    if (added.size() > kResetThreshold) {
+        emit remindersReset();
+        return;
+    }
+    for (const Reminder &reminder : added) {
+        emit reminderAdded(reminder);
+    }
+}
+
+void ReminderManager::emitUpdates(const QVector<Update> &updates)
+{
+    if (updates.size() > kResetThreshold) {
+        emit remindersReset();
+        return;
+    }
+    for (const Update &update : updates) {
+        emit reminderUpdated(update.reminder, update.fields);
+    }
+}
+
+void ReminderManager::emitRemoved(const QStringList &removed)
+{
+    if (removed.size() > kResetThreshold) {
+        emit remindersReset();
+        return;
+    }
+    for (const QString &id : removed) {
+        emit reminderRemoved(id);
+    }
+}
+
+void ReminderManager::calculateNextTrigger(Reminder &reminder, const Recurrence::Advance &advance, bool logEach) const
+{
+    if (reminder.type() == Reminder::Type::Once) {
         // 一次性提醒触发后，标记为已完成
         reminder.setCompleted(true);
-        LOG_INFO(QString("一次性提醒已完成，标记 completed"));
-        return;
-    } else if (type == Reminder::Type::Daily) {
-        nextTrigger = toMinutePrecision(reminder.nextTrigger().addDays(1));
-        LOG_INFO(QString("每日提醒，下次触发时间: %1").arg(nextTrigger.toString(kDateTimeFormat)));
-    } else if (type == Reminder::Type::Workday) {
-        const bool hasValidTrigger = reminder.nextTrigger().isValid();
-        QDate baseDate = hasValidTrigger
-            ? reminder.nextTrigger().date().addDays(1)
-            : QDate::currentDate();
-        if (!baseDate.isValid()) {
-            baseDate = QDate::currentDate();
-        }
-        WorkdayCalendar &calendar = WorkdayCalendar::instance();
-        const QDate nextDate = calendar.nextWorkday(baseDate, true);
-        const QTime triggerTime = hasValidTrigger
-            ? reminder.nextTrigger().time()
-            : QTime::currentTime();
-        if (nextDate.isValid()) {
-            nextTrigger = QDateTime(nextDate, triggerTime);
-        } else {
-            nextTrigger = QDateTime(baseDate, triggerTime);
+        if (logEach) {
+            LOG_INFO(QString("一次性提醒已完成，标记 completed"));
         }
-        nextTrigger = toMinutePrecision(nextTrigger);
-        LOG_INFO(QString("工作日提醒，下次触发时间: %1").arg(nextTrigger.toString(kDateTimeFormat)));
+        return;
+    }
+    reminder.setNextTrigger(advance.next);
+    if (logEach) {
+        LOG_INFO(QString("下次触发时间设置为: %1").arg(reminder.nextTrigger().toString(kDateTimeFormat)));
     }
-
-    reminder.setNextTrigger(nextTrigger);
-    LOG_INFO(QString("下次触发时间设置为: %1").arg(nextTrigger.toString(kDateTimeFormat)));
 }
 
-bool ReminderManager::shouldTrigger(const Reminder &reminder) const
+bool ReminderManager::shouldTrigger(const Reminder &reminder, qint64 nowMinute) const
 {
     if (reminder.completed()) {
-        LOG_DEBUG(QString("提醒 [%1] 已完成，跳过触发检查").arg(reminder.id()));
         return false;
     }
-    
-    QDateTime currentTime = QDateTime::currentDateTime();
-    QDateTime nextTrigger = reminder.nextTrigger();
-    
-    if (!nextTrigger.isValid()) {
+    if (!reminder.hasNextTrigger()) {
         LOG_ERROR(QString("检查提醒 [%1] 是否触发: 无效的触发时间格式")
             .arg(reminder.id()));
         return false;
     }
-    
-    // 计算时间差（毫秒）
-    qint64 timeDiff = currentTime.msecsTo(nextTrigger);
-    bool shouldTrigger = timeDiff <= 0;
-    
-    LOG_DEBUG(QString("检查提醒 [%1] 是否触发: 当前时间 = %2, 触发时间 = %3, 时间差 = %4ms, 结果 = %5")
-        .arg(reminder.id())
-        .arg(currentTime.toString("yyyy-MM-dd HH:mm:ss.zzz"))
-        .arg(nextTrigger.toString("yyyy-MM-dd HH:mm:ss.zzz"))
-        .arg(timeDiff)
-        .arg(shouldTrigger ? "是" : "否"));
-        
-    return shouldTrigger;
+    return reminder.nextTriggerMinute() <= nowMinute;
 }
 
-
-QJsonArray ReminderManager::getRemindersJson() const
-{
-    QJsonArray array;
-    for (const Reminder &reminder : m_reminders) {
-        array.append(reminder.toJson());
-    }
-    return array;
-}
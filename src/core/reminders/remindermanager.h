@@ -3,48 +3,206 @@
 
 #include <QObject>
 #include <QTimer>
-#include <QJsonArray>
-#include "ui/notifications/notificationPopup.h"
 #include <QVector>
 #include "core/reminders/reminder.h"
+#include "core/reminders/reminderstore.h"
+#include "core/reminders/triggerqueue.h"
+#include "core/reminders/reminderjournal.h"
+#include "core/reminders/recurrence.h"
 #include "core/config/configmanager.h"
-#include <QRecursiveMutex>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QSet>
+#include <array>
+#include <atomic>
+#include <memory>
 
+class QThread;
+
+// 某一时刻提醒集合的只读快照。写入方每次变更后发布新快照并递增代号，
+// 读取方无需加锁即可拿到当前快照，代号未变时可以跳过刷新。
+// 每个分片对应一段隐式共享的数组，发布时只替换发生变化的分片。
+struct ReminderSnapshot {
+    quint64 generation = 0;
+    QVector<QVector<Reminder>> parts;
+
+    template <typename Fn>
+    void forEach(Fn fn) const
+    {
+        for (const QVector<Reminder> &part : parts) {
+            for (const Reminder &reminder : part) {
+                fn(reminder);
+            }
+        }
+    }
+    QVector<Reminder> toVector() const;
+};
+using ReminderSnapshotPtr = std::shared_ptr<const ReminderSnapshot>;
+
+// 提醒调度器，定时器运行在独立的调度线程上。
+// 提醒按 ID 哈希分布到若干分片，每个分片有自己的存储、到期队列和一把普通互斥锁，
+// 不同分片上的修改与调度互不阻塞。同一时刻至多持有一个分片锁（重建队列、发布快照
+// 按下标升序逐个加锁），信号发送与数据库写入都在分片锁之外进行。
+// 公共接口可在任意线程调用，与界面之间只通过排队信号通信。
+// 近期窗口模式（ConfigManager::schedulerHorizonHours() 大于 0）下内存中只保留窗口内到期的
+// 未完成提醒：启动时按范围查询调入，窗口随时间滑动分段调入后续提醒，触发后推进到窗口之外
+// 或已完成的提醒写入数据库后静默移出内存（不发出 reminderRemoved）。快照与变更通知只覆盖内存中的提醒，
+// 因此该模式只对没有提醒列表的调用方（守护进程、模拟）开放，界面程序总是全部加载。
+// 不在内存中的提醒同样可以修改与删除（直接写入数据库），添加时连同数据库一起查重。
 class ReminderManager : public QObject
 {
     Q_OBJECT
 
 public:
-    explicit ReminderManager(QObject *parent = nullptr);
+    // FromConfig 时按 ConfigManager::schedulerHorizonHours() 决定是否启用近期窗口模式
+    enum class HorizonPolicy {
+        Disabled,
+        FromConfig
+    };
+
+    explicit ReminderManager(QObject *parent = nullptr, HorizonPolicy horizon = HorizonPolicy::Disabled);
     ~ReminderManager();
 
     void addReminder(const Reminder &reminder);
     void updateReminder(const Reminder &reminder);
     void deleteReminder(const Reminder &reminder);
+
+    // 批量接口：每个分片加锁一次，整批一次写入事务、一次变更通知
+    void addReminders(const QVector<Reminder> &reminders);
+    void updateReminders(const QVector<Reminder> &reminders);
+    void deleteReminders(const QStringList &ids);
+
     QVector<Reminder> getReminders() const;
+    // 不加锁读取当前快照，可在任意线程调用；返回值永不为空
+    ReminderSnapshotPtr snapshot() const;
+    quint64 generation() const;
 
     void pauseAll();
     void resumeAll();
-    void saveReminders();
+    // 同步落盘，返回 false 表示写入失败（变更保留在写后日志中继续重试）
+    bool saveReminders();
+
+    // 模拟/测试驱动：关闭内部定时器后由调用方在推进虚拟时钟后调用 processDue()
+    void setManualDispatch(bool manual);
+    QDateTime nextDueTime() const;
+    void processDue();
+
+    // 同一轮到期数量达到该值时，下一次触发时间分发到全局线程池并行推算；默认 kDefaultBurstThreshold
+    void setBurstThreshold(int threshold);
+
+    // 近期窗口的分钟数，0 表示未启用
+    qint64 horizonMinutes() const;
+
+    // 调度检查被执行的累计次数（定时器到期与 processDue），用于核对空闲开销
+    quint64 wakeupCount() const;
+    // 检测到墙上时间跳变（校时、休眠唤醒）的次数
+    quint64 clockJumpCount() const;
 
 signals:
-    void reminderTriggered(const Reminder &reminder);
+    // 同一轮检查中触发的提醒合并为一次信号（内容为触发前的状态）。
+    // dispatchedAtUs 为发出信号时的 TriggerStats::monotonicMicros()，接收方可据此统计显示延迟
+    void remindersTriggered(const QVector<Reminder> &reminders, qint64 dispatchedAtUs);
+    // 按 FireAll 策略补发：一条汇总通知代替错过的 missedCount 次触发
+    void reminderMissed(const Reminder &reminder, int missedCount);
+    // 细粒度变更通知：在分片锁之外、快照发布之后发出，任何来源（界面、导入、调度）的修改都会经过这里。
+    // 一次变更涉及的提醒超过 kResetThreshold 个时改发 remindersReset，接收方应从快照整体重新加载
+    void reminderAdded(const Reminder &reminder);
+    void reminderUpdated(const Reminder &reminder, Reminder::Fields fields);
+    void reminderRemoved(const QString &id);
+    void remindersReset();
 
 private slots:
     void checkReminders();
+    void rearmTimer();
+    void stopOnSchedulerThread();
 
 private:
+    static constexpr int kShardCount = 16;
+    static constexpr int kResetThreshold = 256;
+    static constexpr int kDefaultBurstThreshold = 256;
+    // 窗口每滑过 1/kHorizonSteps 的长度调入一次后续提醒
+    static constexpr int kHorizonSteps = 4;
+
+    struct Shard {
+        mutable QMutex mutex;
+        ReminderStore store;
+        std::unique_ptr<TriggerQueue> queue;
+    };
+
+    // 一轮检查中的一个到期提醒：锁内复制出来，锁外推算，再按分片写回
+    struct DueItem {
+        Reminder original;    // 取出时的状态，写回时据此发现并发修改
+        Reminder reminder;    // 推算后的状态
+        int shard = 0;
+        bool notify = false;  // 是否发出通知
+        int missedCount = 0;  // 大于 0 时按 FireAll 补发汇总通知
+        qint64 lateMs = -1;   // 普通触发时的迟到毫秒数，计入触发延迟；补发为 -1
+    };
+
+    // 一次修改后要发出的 reminderUpdated
+    struct Update {
+        Reminder reminder;
+        Reminder::Fields fields;
+    };
+
+    static int shardIndex(const ReminderId &id);
+
     void setupTimer();
-    void calculateNextTrigger(Reminder &reminder);
-    bool shouldTrigger(const Reminder &reminder) const;
-    QJsonArray getRemindersJson() const;
+    void startSchedulerThread();
+    void shutdown();
+    void requestRearm();
+    // 要求调用方持有 shard 的锁
+    void scheduleReminder(Shard &shard, const Reminder &reminder);
+    // 不访问分片，可在线程池中并行调用；logEach 为 false 时不逐条写日志
+    void advanceDueItem(DueItem &item, qint64 nowMs, const QDateTime &localNow, bool logEach) const;
+    qint64 nextDueMinute() const;
+    bool detectClockJump(qint64 nowMs);
+    void rebuildQueues(qint64 nowMinute);
+    void calculateNextTrigger(Reminder &reminder, const Recurrence::Advance &advance, bool logEach) const;
+    bool shouldTrigger(const Reminder &reminder, qint64 nowMinute) const;
+    void emitTriggered(const QVector<DueItem> &due, const QVector<Reminder> &triggered, qint64 passStartUs);
+    void emitAdded(const QVector<Reminder> &added);
+    void emitUpdates(const QVector<Update> &updates);
+    void emitRemoved(const QStringList &removed);
     void loadReminders();
+    qint64 horizonStep() const;
+    // 窗口已调入部分的末端落后当前时间足够多时，从数据库调入 [m_horizonEnd, nowMinute + 窗口) 内的提醒
+    void slideHorizon(qint64 nowMinute);
+    // 窗口模式下 keys 中不在内存里、但已存在于数据库的那些；未启用窗口模式时为空
+    QSet<ReminderId> storedOutsideMemory(const QVector<ReminderId> &keys);
+    // 窗口模式下不应继续留在内存中的提醒（已完成、无触发时间或落在窗口之外）
+    bool beyondHorizon(const Reminder &reminder) const;
+    // changedShards 的第 i 位表示第 i 个分片有变化；调用方不得持有分片锁
+    void publishSnapshot(quint32 changedShards) const;
+    QThread *m_thread;
     QTimer *checkTimer;
-    bool isPaused;
-    mutable QRecursiveMutex mutex;
-    QVector<Reminder> m_reminders;
+    std::atomic<bool> isPaused;
+    std::atomic<bool> m_manualDispatch;
+    std::atomic<int> m_burstThreshold;
+    // 已投递但尚未执行的 rearmTimer，用于合并多线程写入产生的重排请求
+    std::atomic<bool> m_rearmPending;
+    std::atomic<quint64> m_wakeups;
+    Recurrence::CatchUpPolicy m_catchUpPolicy;
+    TriggerQueue::Backend m_backend;
+    // 上次检查时的墙上时间与单调时间，用于发现时间跳变；只在调度线程上访问
+    qint64 m_referenceWallMs;
+    qint64 m_referenceMonotonicMs;
+    std::atomic<quint64> m_clockJumps;
+    // 构造时确定，之后不变
+    qint64 m_horizonMinutes;
+    // 已调入内存的时间范围上界（不含）；只在构造期间与调度线程上修改
+    std::atomic<qint64> m_horizonEnd;
+    std::array<Shard, kShardCount> m_shards;
+    ReminderJournal *m_journal;
+    // 通过 std::atomic_load/atomic_store 访问；发布方之间由 m_snapshotMutex 串行化
+    mutable ReminderSnapshotPtr m_snapshot;
+    mutable QMutex m_snapshotMutex;
+    mutable quint64 m_generation;
+    // 没有任何读取方时（守护进程、模拟）不发布快照，免去存储每次修改时的整段复制。
+    // requested 在构建初始快照之前置位，写入方据此决定是否发布；
+    // ready 在初始快照发布之后置位，读取方据此走无锁路径
+    mutable std::atomic<bool> m_snapshotRequested;
+    mutable std::atomic<bool> m_snapshotReady;
 };
 
-#endif // REMINDERMANAGER_H 
+#endif // REMINDERMANAGER_H
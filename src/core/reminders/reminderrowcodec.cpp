@@ -0,0 +1,56 @@
+#include "core/reminders/reminderrowcodec.h"
+#include <QSqlQuery>
+#include <QVariant>
+#include "core/time/epochminute.h"
+
+namespace ReminderRowCodec {
+
+namespace {
+// 除 next_trigger 外两种表结构的列完全相同
+Reminder readCommon(const QSqlQuery &query, int firstColumn)
+{
+    Reminder reminder;
+    reminder.setId(query.value(firstColumn).toString());
+    reminder.setName(query.value(firstColumn + 1).toString());
+    reminder.setType(Reminder::typeFromInt(query.value(firstColumn + 2).toInt()));
+    // 旧数据中优先级可能为空
+    const QVariant priority = query.value(firstColumn + 3);
+    reminder.setPriority(priority.isNull() ? Reminder::Priority::Medium : Reminder::priorityFromInt(priority.toInt()));
+    reminder.setCompleted(query.value(firstColumn + 5).toBool());
+    return reminder;
+}
+}
+
+QString columns()
+{
+    return QStringLiteral("id, name, type, priority, next_trigger, completed");
+}
+
+void bind(QSqlQuery &query, const Reminder &reminder)
+{
+    query.addBindValue(reminder.id());
+    query.addBindValue(reminder.name());
+    query.addBindValue(static_cast<int>(reminder.type()));
+    query.addBindValue(static_cast<int>(reminder.priority()));
+    query.addBindValue(reminder.hasNextTrigger()
+                       ? QVariant(static_cast<qlonglong>(reminder.nextTriggerMinute()))
+                       : QVariant(QMetaType::fromType<qlonglong>()));
+    query.addBindValue(reminder.completed() ? 1 : 0);
+}
+
+Reminder read(const QSqlQuery &query, int firstColumn)
+{
+    Reminder reminder = readCommon(query, firstColumn);
+    const QVariant nextTrigger = query.value(firstColumn + 4);
+    reminder.setNextTriggerMinute(nextTrigger.isNull() ? EpochMinute::kInvalid : nextTrigger.toLongLong());
+    return reminder;
+}
+
+Reminder readLegacy(const QSqlQuery &query, int firstColumn)
+{
+    Reminder reminder = readCommon(query, firstColumn);
+    reminder.setNextTrigger(QDateTime::fromString(query.value(firstColumn + 4).toString(), Qt::ISODate));
+    return reminder;
+}
+
+}
@@ -0,0 +1,29 @@
+#ifndef REMINDERROWCODEC_H
+#define REMINDERROWCODEC_H
+
+#include <QString>
+#include "core/reminders/reminder.h"
+
+class QSqlQuery;
+
+// 提醒表的一行与 Reminder 之间的直接转换，不经过 QJsonObject。
+// JSON（Reminder::toJson/fromJson）只留给导入导出使用。
+// 当前表结构（reminders_v2）中 next_trigger 为 UTC 纪元分钟整数，没有触发时间时为 NULL；
+// 旧表（reminders）中为本地时间的 ISO 文本，只在迁移期间通过 readLegacy 读取。
+namespace ReminderRowCodec {
+
+// SELECT 与 INSERT 共用的列顺序，两种表结构相同
+QString columns();
+
+// 按 columns() 的顺序依次 addBindValue（当前表结构）
+void bind(QSqlQuery &query, const Reminder &reminder);
+
+// 从当前行的 firstColumn 列起按 columns() 的顺序读取（当前表结构）
+Reminder read(const QSqlQuery &query, int firstColumn = 0);
+
+// 同上，但 next_trigger 按旧表的 ISO 文本解析
+Reminder readLegacy(const QSqlQuery &query, int firstColumn = 0);
+
+}
+
+#endif // REMINDERROWCODEC_H
@@ -0,0 +1,65 @@
+#include "core/reminders/reminderstore.h"
+#include <utility>
+
+Reminder *ReminderStore::find(const ReminderId &id)
+{
+    auto it = m_slots.constFind(id);
+    return it == m_slots.constEnd() ? nullptr : &m_items[it.value()];
+}
+
+const Reminder *ReminderStore::find(const ReminderId &id) const
+{
+    auto it = m_slots.constFind(id);
+    return it == m_slots.constEnd() ? nullptr : &m_items[it.value()];
+}
+
+bool ReminderStore::insert(const Reminder &reminder)
+{
+    if (m_slots.contains(reminder.key())) {
+        return false;
+    }
+    m_slots.insert(reminder.key(), m_items.size());
+    m_items.append(reminder);
+    return true;
+}
+
+bool ReminderStore::update(const Reminder &reminder)
+{
+    Reminder *existing = find(reminder.key());
+    if (!existing) {
+        return false;
+    }
+    *existing = reminder;
+    return true;
+}
+
+bool ReminderStore::remove(const ReminderId &id)
+{
+    auto it = m_slots.find(id);
+    if (it == m_slots.end()) {
+        return false;
+    }
+    const int slot = it.value();
+    m_slots.erase(it);
+
+    // 用最后一个元素填补被删除的位置
+    const int last = m_items.size() - 1;
+    if (slot != last) {
+        m_items[slot] = std::move(m_items[last]);
+        m_slots[m_items[slot].key()] = slot;
+    }
+    m_items.removeLast();
+    return true;
+}
+
+void ReminderStore::clear()
+{
+    m_items.clear();
+    m_slots.clear();
+}
+
+void ReminderStore::reserve(int size)
+{
+    m_items.reserve(size);
+    m_slots.reserve(size);
+}
@@ -0,0 +1,34 @@
+#ifndef REMINDERSTORE_H
+#define REMINDERSTORE_H
+
+#include <QHash>
+#include <QVector>
+#include "core/reminders/reminder.h"
+
+// 提醒的内存存储：连续数组 + 定长 ID -> 下标的哈希索引。
+// 查找、插入、更新、删除均为 O(1) 均摊；删除时用末尾元素填补空位，
+// 不会移动其后的元素，因此元素顺序不保证稳定。
+class ReminderStore
+{
+public:
+    int size() const { return m_items.size(); }
+    bool isEmpty() const { return m_items.isEmpty(); }
+    bool contains(const ReminderId &id) const { return m_slots.contains(id); }
+
+    Reminder *find(const ReminderId &id);
+    const Reminder *find(const ReminderId &id) const;
+
+    bool insert(const Reminder &reminder); // id 已存在时返回 false
+    bool update(const Reminder &reminder); // id 不存在时返回 false
+    bool remove(const ReminderId &id);
+    void clear();
+    void reserve(int size);
+
+    const QVector<Reminder> &items() const { return m_items; }
+
+private:
+    QVector<Reminder> m_items;
+    QHash<ReminderId, int> m_slots;
+};
+
+#endif // REMINDERSTORE_H
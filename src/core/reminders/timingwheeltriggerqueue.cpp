@@ -0,0 +1,240 @@
+#include "core/reminders/timingwheeltriggerqueue.h"
+#include <limits>
+#include <utility>
+
+namespace {
+constexpr qint64 kMinutesPerHour = 60;
+constexpr qint64 kMinutesPerDay = 24 * 60;
+
+qint64 floorDiv(qint64 a, qint64 b)
+{
+    qint64 q = a / b;
+    if ((a % b != 0) && ((a < 0) != (b < 0))) {
+        --q;
+    }
+    return q;
+}
+
+int floorMod(qint64 a, qint64 b)
+{
+    return static_cast<int>(a - floorDiv(a, b) * b);
+}
+
+// 不小于 value 的 step 整数倍
+qint64 ceilTo(qint64 value, qint64 step)
+{
+    return floorDiv(value + step - 1, step) * step;
+}
+}
+
+TimingWheelTriggerQueue::TimingWheelTriggerQueue(qint64 nowMinute)
+    : m_minutes(kMinuteSlots)
+    , m_hours(kHourSlots)
+    , m_days(kDaySlots)
+    , m_cursor(nowMinute - 1)
+{
+}
+
+void TimingWheelTriggerQueue::schedule(const ReminderId &id, qint64 dueMinute)
+{
+    cancel(id);
+    if (dueMinute == EpochMinute::kInvalid) {
+        return;
+    }
+    place(id, dueMinute);
+}
+
+void TimingWheelTriggerQueue::cancel(const ReminderId &id)
+{
+    auto it = m_locations.find(id);
+    if (it == m_locations.end()) {
+        return;
+    }
+    const Location loc = it.value();
+    m_locations.erase(it);
+    bucket(loc.level, loc.slot).remove(id, loc.dueMinute);
+    if (loc.level <= Level::Day) {
+        --m_wheelCounts[static_cast<int>(loc.level)];
+    }
+}
+
+void TimingWheelTriggerQueue::clear()
+{
+    for (Bucket &slot : m_minutes) {
+        slot.clear();
+    }
+    for (Bucket &slot : m_hours) {
+        slot.clear();
+    }
+    for (Bucket &slot : m_days) {
+        slot.clear();
+    }
+    m_overflow.clear();
+    m_expired.clear();
+    m_locations.clear();
+    m_wheelCounts[0] = m_wheelCounts[1] = m_wheelCounts[2] = 0;
+}
+
+qint64 TimingWheelTriggerQueue::nextDue() const
+{
+    // 高层条目可能是按更早的游标放置的，因此各层取最早值后再比较；
+    // 每层只看第一个非空槽位的首键，不遍历槽内条目
+    qint64 earliest = std::numeric_limits<qint64>::max();
+    auto consider = [&earliest](const Bucket &slot) {
+        if (!slot.isEmpty()) {
+            earliest = qMin(earliest, slot.earliest());
+        }
+    };
+    consider(m_expired);
+    const qint64 start = m_cursor + 1;
+
+    if (m_wheelCounts[0] > 0) {
+        for (qint64 minute = start; minute < start + kMinuteSlots; ++minute) {
+            if (!m_minutes[floorMod(minute, kMinuteSlots)].isEmpty()) {
+                earliest = qMin(earliest, minute);
+                break;
+            }
+        }
+    }
+    if (m_wheelCounts[1] > 0) {
+        const qint64 startHour = floorDiv(start, kMinutesPerHour);
+        for (qint64 hour = startHour; hour < startHour + kHourSlots; ++hour) {
+            const Bucket &slot = m_hours[floorMod(hour, kHourSlots)];
+            if (!slot.isEmpty()) {
+                consider(slot);
+                break;
+            }
+        }
+    }
+    if (m_wheelCounts[2] > 0) {
+        const qint64 startDay = floorDiv(start, kMinutesPerDay);
+        for (qint64 day = startDay; day < startDay + kDaySlots; ++day) {
+            const Bucket &slot = m_days[floorMod(day, kDaySlots)];
+            if (!slot.isEmpty()) {
+                consider(slot);
+                break;
+            }
+        }
+    }
+    consider(m_overflow);
+
+    if (earliest == std::numeric_limits<qint64>::max()) {
+        return EpochMinute::kInvalid;
+    }
+    return earliest;
+}
+
+QVector<ReminderId> TimingWheelTriggerQueue::takeDue(qint64 nowMinute)
+{
+    QVector<ReminderId> due;
+    for (const ReminderId &id : std::as_const(m_expired.ids)) {
+        m_locations.remove(id);
+        due.append(id);
+    }
+    m_expired.clear();
+
+    advanceTo(nowMinute, due);
+    return due;
+}
+
+void TimingWheelTriggerQueue::place(const ReminderId &id, qint64 dueMinute)
+{
+    const qint64 start = m_cursor + 1;
+    Location loc{dueMinute, Level::Overflow, 0};
+
+    if (dueMinute < start) {
+        loc.level = Level::Expired;
+    } else if (dueMinute - start < kMinuteSlots) {
+        loc.level = Level::Minute;
+        loc.slot = floorMod(dueMinute, kMinuteSlots);
+    } else if (floorDiv(dueMinute, kMinutesPerHour) - floorDiv(start, kMinutesPerHour) < kHourSlots) {
+        loc.level = Level::Hour;
+        loc.slot = floorMod(floorDiv(dueMinute, kMinutesPerHour), kHourSlots);
+    } else if (floorDiv(dueMinute, kMinutesPerDay) - floorDiv(start, kMinutesPerDay) < kDaySlots) {
+        loc.level = Level::Day;
+        loc.slot = floorMod(floorDiv(dueMinute, kMinutesPerDay), kDaySlots);
+    }
+
+    bucket(loc.level, loc.slot).insert(id, dueMinute);
+    if (loc.level <= Level::Day) {
+        ++m_wheelCounts[static_cast<int>(loc.level)];
+    }
+    m_locations.insert(id, loc);
+}
+
+TimingWheelTriggerQueue::Bucket &TimingWheelTriggerQueue::bucket(Level level, int slot)
+{
+    switch (level) {
+    case Level::Minute: return m_minutes[slot];
+    case Level::Hour: return m_hours[slot];
+    case Level::Day: return m_days[slot];
+    case Level::Expired: return m_expired;
+    case Level::Overflow:
+    default: return m_overflow;
+    }
+}
+
+void TimingWheelTriggerQueue::cascade(Bucket &from)
+{
+    // 先整体取出再按新游标重新放置，条目会落到更低一层
+    QSet<ReminderId> ids;
+    ids.swap(from.ids);
+    from.dueCounts.clear();
+    for (const ReminderId &id : std::as_const(ids)) {
+        const Location loc = m_locations.value(id);
+        if (loc.level <= Level::Day) {
+            --m_wheelCounts[static_cast<int>(loc.level)];
+        }
+        place(id, loc.dueMinute);
+    }
+}
+
+void TimingWheelTriggerQueue::advanceTo(qint64 minute, QVector<ReminderId> &due)
+{
+    while (m_cursor < minute) {
+        const qint64 next = m_cursor + 1;
+
+        // 分钟轮为空时直接跳到下一个需要级联的边界
+        if (m_wheelCounts[0] == 0) {
+            qint64 boundary = ceilTo(next, kMinutesPerHour);
+            if (m_wheelCounts[1] == 0) {
+                boundary = ceilTo(next, kMinutesPerDay);
+                if (m_wheelCounts[2] == 0) {
+                    boundary = m_overflow.isEmpty()
+                        ? minute + 1
+                        : ceilTo(next, kMinutesPerDay * kDaySlots);
+                }
+            }
+            if (boundary > next) {
+                m_cursor = qMin(boundary, minute + 1) - 1;
+                continue;
+            }
+        }
+
+        processMinute(next, due);
+    }
+}
+
+void TimingWheelTriggerQueue::processMinute(qint64 minute, QVector<ReminderId> &due)
+{
+    // 处理期间游标停在 minute - 1，place() 以 minute 为起点重新分层
+    if (floorMod(minute, kMinutesPerDay * kDaySlots) == 0 && !m_overflow.isEmpty()) {
+        cascade(m_overflow);
+    }
+    if (floorMod(minute, kMinutesPerDay) == 0) {
+        cascade(m_days[floorMod(floorDiv(minute, kMinutesPerDay), kDaySlots)]);
+    }
+    if (floorMod(minute, kMinutesPerHour) == 0) {
+        cascade(m_hours[floorMod(floorDiv(minute, kMinutesPerHour), kHourSlots)]);
+    }
+
+    Bucket &slot = m_minutes[floorMod(minute, kMinuteSlots)];
+    for (const ReminderId &id : std::as_const(slot.ids)) {
+        m_locations.remove(id);
+        due.append(id);
+    }
+    m_wheelCounts[0] -= slot.size();
+    slot.clear();
+
+    m_cursor = minute;
+}
@@ -0,0 +1,96 @@
+#ifndef TIMINGWHEELTRIGGERQUEUE_H
+#define TIMINGWHEELTRIGGERQUEUE_H
+
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QVector>
+#include "core/reminders/triggerqueue.h"
+
+// 分层时间轮：分钟轮(60) / 小时轮(24) / 天轮(366) + 溢出列表。
+// 触发时间本身已按分钟取整，因此以分钟为最小刻度；空闲的分钟/小时/天会被整段跳过。
+// 定位槽位是 O(1)，槽内增删是 O(log d)（d 为该槽内不同到期分钟数，见 Bucket），
+// 到期取出每个条目均摊 O(log d)。nextDue() 每个槽位只取首键，不随槽内条目数增长。
+class TimingWheelTriggerQueue : public TriggerQueue
+{
+public:
+    explicit TimingWheelTriggerQueue(qint64 nowMinute);
+
+    void schedule(const ReminderId &id, qint64 dueMinute) override;
+    void cancel(const ReminderId &id) override;
+    void clear() override;
+
+    int size() const override { return m_locations.size(); }
+    qint64 nextDue() const override;
+    QVector<ReminderId> takeDue(qint64 nowMinute) override;
+
+private:
+    enum class Level : quint8 {
+        Minute,
+        Hour,
+        Day,
+        Overflow,
+        Expired // 插入时已早于游标，下次 takeDue 直接返回
+    };
+
+    struct Location {
+        qint64 dueMinute;
+        Level level;
+        int slot;
+    };
+
+    // 一个槽位：条目集合 + 到期分钟计数。
+    // ids 的增删为平均 O(1)；dueCounts 的增删为 O(log d)，d 为槽内不同到期分钟数：
+    // 分钟槽 d = 1，小时槽 d <= 60，天槽 d <= 1440，溢出与已过期槽位不设上限。
+    // earliest() 取首键为 O(1)。之所以不用侵入式链表加惰性最小值，是因为删除最早条目后
+    // 重新求最小值要扫描整个槽位（O(k)），在大量提醒集中于同一天时反而更慢
+    struct Bucket {
+        QSet<ReminderId> ids;
+        QMap<qint64, int> dueCounts;
+
+        bool isEmpty() const { return ids.isEmpty(); }
+        int size() const { return ids.size(); }
+        qint64 earliest() const { return dueCounts.isEmpty() ? EpochMinute::kInvalid : dueCounts.firstKey(); }
+        void insert(const ReminderId &id, qint64 dueMinute)
+        {
+            ids.insert(id);
+            ++dueCounts[dueMinute];
+        }
+        void remove(const ReminderId &id, qint64 dueMinute)
+        {
+            if (!ids.remove(id)) {
+                return;
+            }
+            auto it = dueCounts.find(dueMinute);
+            if (it != dueCounts.end() && --it.value() == 0) {
+                dueCounts.erase(it);
+            }
+        }
+        void clear()
+        {
+            ids.clear();
+            dueCounts.clear();
+        }
+    };
+
+    static constexpr int kMinuteSlots = 60;
+    static constexpr int kHourSlots = 24;
+    static constexpr int kDaySlots = 366;
+
+    void place(const ReminderId &id, qint64 dueMinute);
+    Bucket &bucket(Level level, int slot);
+    void cascade(Bucket &from);
+    void advanceTo(qint64 minute, QVector<ReminderId> &due);
+    void processMinute(qint64 minute, QVector<ReminderId> &due);
+
+    QVector<Bucket> m_minutes;
+    QVector<Bucket> m_hours;
+    QVector<Bucket> m_days;
+    Bucket m_overflow;
+    Bucket m_expired;
+    QHash<ReminderId, Location> m_locations;
+    int m_wheelCounts[3] = {0, 0, 0}; // 分钟/小时/天轮中的条目数，用于跳过空段
+    qint64 m_cursor;                  // 已处理完的最后一分钟
+};
+
+#endif // TIMINGWHEELTRIGGERQUEUE_H
@@ -0,0 +1,39 @@
+#include "core/reminders/triggerqueue.h"
+#include "core/reminders/heaptriggerqueue.h"
+#include "core/reminders/lineartriggerqueue.h"
+#include "core/reminders/timingwheeltriggerqueue.h"
+
+std::unique_ptr<TriggerQueue> TriggerQueue::create(Backend backend, qint64 nowMinute)
+{
+    switch (backend) {
+    case Backend::TimingWheel:
+        return std::make_unique<TimingWheelTriggerQueue>(nowMinute);
+    case Backend::Linear:
+        return std::make_unique<LinearTriggerQueue>();
+    case Backend::Heap:
+    default:
+        return std::make_unique<HeapTriggerQueue>();
+    }
+}
+
+TriggerQueue::Backend TriggerQueue::backendFromString(const QString &name)
+{
+    const QString key = name.trimmed().toLower();
+    if (key == QLatin1String("wheel")) {
+        return Backend::TimingWheel;
+    }
+    if (key == QLatin1String("linear")) {
+        return Backend::Linear;
+    }
+    return Backend::Heap;
+}
+
+QString TriggerQueue::backendName(Backend backend)
+{
+    switch (backend) {
+    case Backend::TimingWheel: return QStringLiteral("wheel");
+    case Backend::Linear: return QStringLiteral("linear");
+    case Backend::Heap:
+    default: return QStringLiteral("heap");
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef TRIGGERQUEUE_H
+#define TRIGGERQUEUE_H
+
+#include <QString>
+#include <QVector>
+#include <memory>
+#include "core/reminders/reminderid.h"
+#include "core/time/epochminute.h"
+
+// 到期队列接口：ReminderManager 只依赖它来获知最早到期时间和取出到期提醒。
+// 时间均为 UTC 纪元分钟（见 EpochMinute）。具体实现可通过配置切换，便于对比不同规模下的开销。
+class TriggerQueue
+{
+public:
+    enum class Backend {
+        Heap,        // 最小堆，O(log n)
+        TimingWheel, // 分层时间轮，O(1)
+        Linear       // 线性扫描，O(n)，用于对比
+    };
+
+    static std::unique_ptr<TriggerQueue> create(Backend backend, qint64 nowMinute);
+    static Backend backendFromString(const QString &name);
+    static QString backendName(Backend backend);
+
+    virtual ~TriggerQueue() = default;
+
+    // 新增或重新调度；dueMinute 为 EpochMinute::kInvalid 时等同于 cancel
+    virtual void schedule(const ReminderId &id, qint64 dueMinute) = 0;
+    virtual void cancel(const ReminderId &id) = 0;
+    virtual void clear() = 0;
+
+    virtual int size() const = 0;
+    bool isEmpty() const { return size() == 0; }
+    // 最早到期分钟；队列为空时返回 EpochMinute::kInvalid
+    virtual qint64 nextDue() const = 0;
+
+    // 取出所有到期分钟不晚于 nowMinute 的提醒 ID
+    virtual QVector<ReminderId> takeDue(qint64 nowMinute) = 0;
+};
+
+#endif // TRIGGERQUEUE_H
@@ -0,0 +1,100 @@
+#include "core/reminders/triggerstats.h"
+#include <chrono>
+#include "core/logging/logger.h"
+
+namespace {
+// 摘要日志的最小间隔
+constexpr qint64 kSummaryIntervalUs = 30LL * 60 * 1000 * 1000;
+
+QString formatMs(qint64 us)
+{
+    return QString::number(us / 1000.0, 'f', 1);
+}
+}
+
+TriggerStats &TriggerStats::instance()
+{
+    static TriggerStats instance;
+    return instance;
+}
+
+TriggerStats::TriggerStats()
+    : m_lastSummaryUs(monotonicMicros())
+{
+}
+
+qint64 TriggerStats::monotonicMicros()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void TriggerStats::recordTriggerDelay(qint64 delayUs)
+{
+    QMutexLocker locker(&m_mutex);
+    m_triggerDelay.record(delayUs);
+    logSummaryIfDueLocked();
+}
+
+void TriggerStats::recordDisplayDelay(qint64 delayUs)
+{
+    QMutexLocker locker(&m_mutex);
+    m_displayDelay.record(delayUs);
+    logSummaryIfDueLocked();
+}
+
+TriggerStats::Summary TriggerStats::triggerDelay() const
+{
+    QMutexLocker locker(&m_mutex);
+    return summarize(m_triggerDelay);
+}
+
+TriggerStats::Summary TriggerStats::displayDelay() const
+{
+    QMutexLocker locker(&m_mutex);
+    return summarize(m_displayDelay);
+}
+
+QString TriggerStats::summaryText() const
+{
+    QMutexLocker locker(&m_mutex);
+    return summaryTextLocked();
+}
+
+void TriggerStats::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_triggerDelay.reset();
+    m_displayDelay.reset();
+    m_lastSummaryUs = monotonicMicros();
+}
+
+TriggerStats::Summary TriggerStats::summarize(const LatencyHistogram &histogram)
+{
+    Summary summary;
+    summary.count = histogram.count();
+    summary.p50Us = histogram.valueAtPercentile(50.0);
+    summary.p99Us = histogram.valueAtPercentile(99.0);
+    summary.maxUs = histogram.max();
+    return summary;
+}
+
+void TriggerStats::logSummaryIfDueLocked()
+{
+    const qint64 now = monotonicMicros();
+    if (now - m_lastSummaryUs < kSummaryIntervalUs) {
+        return;
+    }
+    m_lastSummaryUs = now;
+    LOG_INFO(summaryTextLocked());
+}
+
+QString TriggerStats::summaryTextLocked() const
+{
+    const Summary trigger = summarize(m_triggerDelay);
+    const Summary display = summarize(m_displayDelay);
+    return QString("触发延迟统计: 触发 %1 次 p50=%2ms p99=%3ms max=%4ms; "
+                   "弹窗 %5 次 p50=%6ms p99=%7ms max=%8ms")
+        .arg(trigger.count).arg(formatMs(trigger.p50Us), formatMs(trigger.p99Us), formatMs(trigger.maxUs))
+        .arg(display.count).arg(formatMs(display.p50Us), formatMs(display.p99Us), formatMs(display.maxUs));
+}
@@ -0,0 +1,48 @@
+#ifndef TRIGGERSTATS_H
+#define TRIGGERSTATS_H
+
+#include <QMutex>
+#include <QString>
+#include "core/reminders/latencyhistogram.h"
+
+// 提醒触发延迟统计：
+//  - 触发延迟：提醒到期时间到调度器发出 remindersTriggered 的时间差；
+//  - 显示延迟：调度器发出信号到界面弹窗 show() 完成的时间差。
+// 可在任意线程记录与查询。摘要日志只在记录时顺带输出，空闲时不会唤醒。
+class TriggerStats
+{
+public:
+    struct Summary {
+        qint64 count = 0;
+        qint64 p50Us = 0;
+        qint64 p99Us = 0;
+        qint64 maxUs = 0;
+    };
+
+    static TriggerStats &instance();
+
+    // 单调时钟时间戳（微秒），用于跨线程计算显示延迟
+    static qint64 monotonicMicros();
+
+    void recordTriggerDelay(qint64 delayUs);
+    void recordDisplayDelay(qint64 delayUs);
+
+    Summary triggerDelay() const;
+    Summary displayDelay() const;
+    QString summaryText() const;
+    void reset();
+
+private:
+    TriggerStats();
+
+    static Summary summarize(const LatencyHistogram &histogram);
+    void logSummaryIfDueLocked();
+    QString summaryTextLocked() const;
+
+    mutable QMutex m_mutex;
+    LatencyHistogram m_triggerDelay;
+    LatencyHistogram m_displayDelay;
+    qint64 m_lastSummaryUs;
+};
+
+#endif // TRIGGERSTATS_H
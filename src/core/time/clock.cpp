@@ -0,0 +1,71 @@
+#include "core/time/clock.h"
+#include <chrono>
+
+namespace {
+SystemClock &systemClock()
+{
+    static SystemClock clock;
+    return clock;
+}
+
+std::atomic<Clock *> g_clock{nullptr};
+}
+
+Clock &Clock::instance()
+{
+    Clock *clock = g_clock.load(std::memory_order_acquire);
+    return clock ? *clock : systemClock();
+}
+
+void Clock::setInstance(Clock *clock)
+{
+    g_clock.store(clock, std::memory_order_release);
+}
+
+QDateTime SystemClock::now() const
+{
+    return QDateTime::currentDateTime();
+}
+
+qint64 SystemClock::nowMSecs() const
+{
+    return QDateTime::currentMSecsSinceEpoch();
+}
+
+qint64 SystemClock::monotonicMsecs() const
+{
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+VirtualClock::VirtualClock(const QDateTime &start)
+    : m_msecs(start.toMSecsSinceEpoch())
+    , m_monotonicMsecs(0)
+{
+}
+
+QDateTime VirtualClock::now() const
+{
+    return QDateTime::fromMSecsSinceEpoch(m_msecs.load(std::memory_order_acquire));
+}
+
+qint64 VirtualClock::nowMSecs() const
+{
+    return m_msecs.load(std::memory_order_acquire);
+}
+
+qint64 VirtualClock::monotonicMsecs() const
+{
+    return m_monotonicMsecs.load(std::memory_order_acquire);
+}
+
+void VirtualClock::setNow(const QDateTime &time)
+{
+    m_msecs.store(time.toMSecsSinceEpoch(), std::memory_order_release);
+}
+
+void VirtualClock::advance(qint64 msecs)
+{
+    m_msecs.fetch_add(msecs, std::memory_order_acq_rel);
+    m_monotonicMsecs.fetch_add(msecs, std::memory_order_acq_rel);
+}
@@ -0,0 +1,54 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <QDate>
+#include <QDateTime>
+#include <atomic>
+
+// 时钟接口：所有需要"当前时间"的调度与日历代码都通过它取时间，
+// 默认使用系统时钟，模拟时替换为可手动推进的虚拟时钟。
+class Clock
+{
+public:
+    virtual ~Clock() = default;
+
+    virtual QDateTime now() const = 0;
+    // 当前 UTC 毫秒时间戳，不做时区换算，调度比较优先使用
+    virtual qint64 nowMSecs() const = 0;
+    // 单调时间（毫秒），不受校时影响；与 now() 对比可发现时间跳变与休眠唤醒
+    virtual qint64 monotonicMsecs() const = 0;
+    QDate today() const { return now().date(); }
+
+    // 进程内当前生效的时钟；setInstance(nullptr) 恢复为系统时钟。
+    // 替换时钟应在创建 ReminderManager 之前完成，调用方保证其生命周期。
+    static Clock &instance();
+    static void setInstance(Clock *clock);
+};
+
+class SystemClock : public Clock
+{
+public:
+    QDateTime now() const override;
+    qint64 nowMSecs() const override;
+    qint64 monotonicMsecs() const override;
+};
+
+// 虚拟时钟：时间只在 setNow()/advance() 时变化，可在任意线程读取。
+// advance() 同时推进墙上时间与单调时间；setNow() 只改墙上时间，模拟校时或休眠唤醒
+class VirtualClock : public Clock
+{
+public:
+    explicit VirtualClock(const QDateTime &start);
+
+    QDateTime now() const override;
+    qint64 nowMSecs() const override;
+    qint64 monotonicMsecs() const override;
+    void setNow(const QDateTime &time);
+    void advance(qint64 msecs);
+
+private:
+    std::atomic<qint64> m_msecs;
+    std::atomic<qint64> m_monotonicMsecs;
+};
+
+#endif // CLOCK_H
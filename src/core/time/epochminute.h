@@ -0,0 +1,42 @@
+#ifndef EPOCHMINUTE_H
+#define EPOCHMINUTE_H
+
+#include <QDateTime>
+#include <limits>
+
+// 调度内部统一使用的时间表示：自 1970-01-01T00:00Z 起的分钟数（UTC）。
+// 比较只是整数比较，不涉及时区换算，夏令时切换时也不会出现重复或缺失的时刻；
+// 只有在界面显示、持久化以及按本地日期推算重复规则时才换算为本地 QDateTime。
+namespace EpochMinute {
+
+constexpr qint64 kInvalid = std::numeric_limits<qint64>::min();
+constexpr qint64 kMsecsPerMinute = 60 * 1000;
+
+inline qint64 fromMSecs(qint64 msecs)
+{
+    // 向下取整，1970 年之前的时间也落在正确的分钟
+    qint64 minute = msecs / kMsecsPerMinute;
+    if (msecs % kMsecsPerMinute != 0 && msecs < 0) {
+        --minute;
+    }
+    return minute;
+}
+
+inline qint64 toMSecs(qint64 minute)
+{
+    return minute * kMsecsPerMinute;
+}
+
+inline qint64 fromDateTime(const QDateTime &dt)
+{
+    return dt.isValid() ? fromMSecs(dt.toMSecsSinceEpoch()) : kInvalid;
+}
+
+inline QDateTime toDateTime(qint64 minute)
+{
+    return minute == kInvalid ? QDateTime() : QDateTime::fromMSecsSinceEpoch(toMSecs(minute));
+}
+
+} // namespace EpochMinute
+
+#endif // EPOCHMINUTE_H
@@ -0,0 +1,28 @@
+# 无界面的提醒调度守护进程，只依赖 QtCore/QtSql/QtConcurrent
+QT = core
+
+TARGET = easynotifyd
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../../common.pri)
+include(../core/easynotifycore.pri)
+
+DESTDIR = $$BIN_DIR
+
+SOURCES += \
+    main.cpp \
+    simulation.cpp
+
+HEADERS += \
+    simulation.h
+
+# --bench-memory 读取进程工作集
+win32: LIBS += -lpsapi
+
+# Default rules for deployment.
+unix:!android: target.path = /opt/EasyNotify/bin
+!isEmpty(target.path): INSTALLS += target
+
+QMAKE_TARGET_PRODUCT = "easynotifyd"
+QMAKE_TARGET_DESCRIPTION = "EasyNotify headless reminder scheduler"
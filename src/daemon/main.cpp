@@ -0,0 +1,216 @@
+#include "core/logging/logger.h"
+#include "core/reminders/remindermanager.h"
+#include "core/reminders/triggerstats.h"
+#include "simulation.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+#ifdef Q_OS_WIN
+#include <windows.h>
+#else
+#include <QSocketNotifier>
+#include <csignal>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#ifdef Q_OS_WIN
+// 控制台事件由系统在独立线程上回调，可以直接向主线程排队投递退出
+BOOL WINAPI handleConsoleEvent(DWORD type)
+{
+    switch (type) {
+    case CTRL_C_EVENT:
+    case CTRL_BREAK_EVENT:
+    case CTRL_CLOSE_EVENT:
+        QMetaObject::invokeMethod(QCoreApplication::instance(), &QCoreApplication::quit,
+                                  Qt::QueuedConnection);
+        return TRUE;
+    default:
+        return FALSE;
+    }
+}
+#else
+// 自管道：信号处理函数只向套接字写一个字节（异步信号安全），
+// 主线程的 QSocketNotifier 读到后退出事件循环，没有信号时不产生任何唤醒
+int g_signalFds[2] = {-1, -1};
+
+void handleTerminationSignal(int)
+{
+    const char byte = 1;
+    // 写失败时套接字里已有未读的字节，退出请求不会丢
+    [[maybe_unused]] const ssize_t written = ::write(g_signalFds[0], &byte, sizeof(byte));
+}
+#endif
+
+void installTerminationHandler(QCoreApplication &app)
+{
+#ifdef Q_OS_WIN
+    Q_UNUSED(app);
+    if (!SetConsoleCtrlHandler(handleConsoleEvent, TRUE)) {
+        LOG_ERROR("注册控制台事件处理失败，Ctrl+C 将直接终止进程");
+    }
+#else
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, g_signalFds) != 0) {
+        LOG_ERROR("创建信号通知套接字失败，终止信号将直接结束进程");
+        return;
+    }
+    auto *notifier = new QSocketNotifier(g_signalFds[1], QSocketNotifier::Read, &app);
+    QObject::connect(notifier, &QSocketNotifier::activated, &app, [notifier, &app]() {
+        notifier->setEnabled(false);
+        char byte = 0;
+        [[maybe_unused]] const ssize_t received = ::read(g_signalFds[1], &byte, sizeof(byte));
+        LOG_INFO("收到终止信号，准备退出");
+        app.quit();
+    });
+    struct sigaction action = {};
+    action.sa_handler = handleTerminationSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+#endif
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    // 与图形界面共用同一组应用信息，从而读写同一份配置与提醒数据
+    QCoreApplication::setApplicationName("EasyNotify");
+    QCoreApplication::setApplicationVersion("1.0.0");
+    QCoreApplication::setOrganizationName("SwartzMss");
+    QCoreApplication::setOrganizationDomain("github.com/SwartzMss");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("EasyNotify 无界面提醒调度守护进程");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption simulateOption("simulate", "使用虚拟时钟快进模拟，输出吞吐量与漏触发统计后退出");
+    QCommandLineOption remindersOption("reminders", "模拟的提醒数量", "count", "100000");
+    QCommandLineOption daysOption("days", "模拟推进的天数", "days", "365");
+    QCommandLineOption backendOption("backend", "模拟使用的调度队列 (heap/wheel/linear)", "name", "heap");
+    QCommandLineOption seedOption("seed", "生成模拟数据的随机种子", "seed", "1");
+    QCommandLineOption benchOption("bench-compare", "测量单次触发判断的比较开销后退出（数量取 --reminders）");
+    QCommandLineOption memoryOption("bench-memory", "测量大规模提醒集合的每条内存占用后退出（数量取 --reminders）");
+    QCommandLineOption scanOption("bench-scan", "测量 1 万/10 万/100 万条提醒的到期扫描开销后退出");
+    QCommandLineOption storeOption("bench-store", "测量 10 万条提醒逐条/整批增删的耗时后退出（数量取 --reminders）");
+    QCommandLineOption contentionOption("bench-contention", "测量多个写线程并发更新提醒的吞吐量后退出（数量取 --reminders）");
+    QCommandLineOption persistOption("bench-persist", "测量表中 100 至 10 万条提醒时单次修改的落盘耗时后退出（上限取 --reminders）");
+    QCommandLineOption burstOption("bench-burst", "测量同一分钟大批提醒同时到期时的处理耗时后退出（数量取 --reminders）");
+    QCommandLineOption databaseOption("bench-db", "测量各数据库档位下的每秒写入次数后退出（数量取 --reminders）");
+    QCommandLineOption codecOption("bench-codec", "对照 JSON 往返与行编解码保存/加载提醒表的耗时后退出（数量取 --reminders）");
+    QCommandLineOption horizonBenchOption("bench-horizon", "对照全部加载与近期窗口模式的启动耗时与内存中提醒数后退出（数量取 --reminders）");
+    QCommandLineOption horizonOption("horizon-hours", "模拟使用的近期窗口小时数（0 表示全部加载）", "hours", "0");
+    QCommandLineOption jumpOption("jump-hours", "模拟中途把墙上时间拨动的小时数（可为负）", "hours", "0");
+    parser.addOption(simulateOption);
+    parser.addOption(remindersOption);
+    parser.addOption(daysOption);
+    parser.addOption(backendOption);
+    parser.addOption(seedOption);
+    parser.addOption(jumpOption);
+    parser.addOption(horizonOption);
+    parser.addOption(benchOption);
+    parser.addOption(memoryOption);
+    parser.addOption(scanOption);
+    parser.addOption(storeOption);
+    parser.addOption(contentionOption);
+    parser.addOption(persistOption);
+    parser.addOption(burstOption);
+    parser.addOption(databaseOption);
+    parser.addOption(codecOption);
+    parser.addOption(horizonBenchOption);
+    parser.process(app);
+
+    // 初始化日志系统
+    Logger::instance();
+
+    if (parser.isSet(benchOption)) {
+        return Simulation::benchmarkComparisons(parser.value(remindersOption).toInt());
+    }
+
+    if (parser.isSet(memoryOption)) {
+        return Simulation::benchmarkMemory(parser.value(remindersOption).toInt());
+    }
+
+    if (parser.isSet(scanOption)) {
+        return Simulation::benchmarkScan();
+    }
+
+    if (parser.isSet(storeOption)) {
+        return Simulation::benchmarkStore(parser.value(remindersOption).toInt());
+    }
+
+    if (parser.isSet(contentionOption)) {
+        return Simulation::benchmarkContention(parser.value(remindersOption).toInt());
+    }
+
+    if (parser.isSet(persistOption)) {
+        return Simulation::benchmarkPersist(parser.value(remindersOption).toInt());
+    }
+
+    if (parser.isSet(burstOption)) {
+        return Simulation::benchmarkBurst(parser.value(remindersOption).toInt());
+    }
+
+    if (parser.isSet(databaseOption)) {
+        return Simulation::benchmarkDatabase(parser.value(remindersOption).toInt());
+    }
+
+    if (parser.isSet(codecOption)) {
+        return Simulation::benchmarkCodec(parser.value(remindersOption).toInt());
+    }
+
+    if (parser.isSet(horizonBenchOption)) {
+        return Simulation::benchmarkHorizon(parser.value(remindersOption).toInt());
+    }
+
+    if (parser.isSet(simulateOption)) {
+        Simulation::Options options;
+        options.reminderCount = qMax(0, parser.value(remindersOption).toInt());
+        options.days = qMax(1, parser.value(daysOption).toInt());
+        options.backend = parser.value(backendOption);
+        options.seed = parser.value(seedOption).toUInt();
+        options.jumpHours = parser.value(jumpOption).toInt();
+        options.horizonHours = qMax(0, parser.value(horizonOption).toInt());
+        LOG_INFO(QString("进入模拟模式: %1 个提醒, %2 天").arg(options.reminderCount).arg(options.days));
+        return Simulation(options).run();
+    }
+
+    LOG_INFO("守护进程启动");
+
+    installTerminationHandler(app);
+
+    // 守护进程没有提醒列表，可以按设置启用近期窗口模式
+    ReminderManager manager(nullptr, ReminderManager::HorizonPolicy::FromConfig);
+
+    // 触发信号来自调度线程，排队送到主线程后写日志与标准输出
+    QObject::connect(&manager, &ReminderManager::remindersTriggered, &app,
+                     [](const QVector<Reminder> &reminders) {
+                         QTextStream out(stdout);
+                         const QString now = QDateTime::currentDateTime().toString(Qt::ISODate);
+                         for (const Reminder &reminder : reminders) {
+                             LOG_INFO(QString("提醒触发: %1").arg(reminder.name()));
+                             out << now << ' ' << reminder.name() << '\n';
+                         }
+                         out.flush();
+                     }, Qt::QueuedConnection);
+    QObject::connect(&manager, &ReminderManager::reminderMissed, &app,
+                     [](const Reminder &reminder, int missedCount) {
+                         LOG_INFO(QString("补发提醒: %1，错过 %2 次").arg(reminder.name()).arg(missedCount));
+                         QTextStream out(stdout);
+                         out << QDateTime::currentDateTime().toString(Qt::ISODate)
+                             << ' ' << reminder.name() << " (missed " << missedCount << ')' << Qt::endl;
+                     }, Qt::QueuedConnection);
+
+    int result = app.exec();
+
+    if (!manager.saveReminders()) {
+        LOG_ERROR("退出前保存提醒数据失败");
+    }
+    LOG_INFO(TriggerStats::instance().summaryText());
+    LOG_INFO(QString("调度唤醒次数: %1").arg(manager.wakeupCount()));
+    LOG_INFO("守护进程退出");
+    return result;
+}
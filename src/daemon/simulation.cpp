@@ -0,0 +1,1196 @@
+#include "simulation.h"
+#include "core/calendar/workdaycalendar.h"
+#include "core/config/configmanager.h"
+#include "core/logging/logger.h"
+#include "core/reminders/duescan.h"
+#include "core/reminders/namepool.h"
+#include "core/reminders/remindermanager.h"
+#include "core/reminders/reminderrowcodec.h"
+#include "core/reminders/reminderstore.h"
+#include "core/time/clock.h"
+#include "core/time/epochminute.h"
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QSet>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#include <atomic>
+#include <limits>
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_LINUX)
+#include <QFile>
+#include <unistd.h>
+#endif
+
+namespace {
+QDateTime toMinutePrecision(const QDateTime &dt)
+{
+    QDateTime rounded(dt);
+    const QTime t = rounded.time();
+    rounded.setTime(QTime(t.hour(), t.minute()));
+    return rounded;
+}
+
+// 用给定的随机数发生器生成 v4 UUID，保证同一种子得到同一组提醒 ID
+ReminderId seededId(QRandomGenerator &rng)
+{
+    quint32 words[4];
+    rng.fillRange(words);
+    const QUuid uuid(words[0],
+                     static_cast<ushort>(words[1]),
+                     static_cast<ushort>(((words[1] >> 16) & 0x0FFF) | 0x4000),
+                     static_cast<uchar>((words[2] & 0x3F) | 0x80),
+                     static_cast<uchar>(words[2] >> 8),
+                     static_cast<uchar>(words[2] >> 16),
+                     static_cast<uchar>(words[2] >> 24),
+                     static_cast<uchar>(words[3]),
+                     static_cast<uchar>(words[3] >> 8),
+                     static_cast<uchar>(words[3] >> 16),
+                     static_cast<uchar>(words[3] >> 24));
+    return ReminderId::fromUuid(uuid);
+}
+
+// 当前进程的常驻内存字节数；平台不支持时返回 -1
+qint64 residentBytes()
+{
+#ifdef Q_OS_WIN
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<qint64>(counters.WorkingSetSize);
+    }
+    return -1;
+#elif defined(Q_OS_LINUX)
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (!statm.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2) {
+        return -1;
+    }
+    return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+#else
+    return -1;
+#endif
+}
+
+// 从提醒的首次触发时间到 t（含）之间应触发的次数，独立于调度器推算
+int occurrencesThrough(const Reminder &reminder, const QDateTime &t)
+{
+    const QDateTime first = reminder.nextTrigger();
+    if (!first.isValid() || first > t) {
+        return 0;
+    }
+    if (reminder.type() == Reminder::Type::Once) {
+        return 1;
+    }
+    const QTime time = first.time();
+    const QDate last = QDateTime(t.date(), time) <= t ? t.date() : t.date().addDays(-1);
+    if (reminder.type() == Reminder::Type::Daily) {
+        return static_cast<int>(first.date().daysTo(last)) + 1;
+    }
+    return WorkdayCalendar::instance().workdaysBetween(first.date(), last);
+}
+
+// 基准测试的公共准备：数据库放在临时目录中，日志降到警告级别，避免逐条 INFO 干扰计时。
+// 返回 false 时调用方以退出码 2 结束
+bool prepareBenchDatabase(const QTemporaryDir &tempDir, const QString &fileName)
+{
+    if (!tempDir.isValid()) {
+        LOG_ERROR("无法创建基准测试用临时目录");
+        return false;
+    }
+    ConfigManager::setDatabasePath(tempDir.filePath(fileName));
+    Logger::instance().setMinimumLevel(Logger::LogLevel::Warning);
+    return true;
+}
+
+// 固定种子生成的每日提醒，名称按 prefix 加序号取 1000 种；
+// 下次触发时间落在 baseMinute 一天之后的 24 小时内，测量期间不会触发
+QVector<Reminder> seededFutureReminders(int count, const QString &prefix, qint64 baseMinute)
+{
+    QRandomGenerator rng(1);
+    QVector<Reminder> reminders;
+    reminders.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        Reminder reminder;
+        reminder.setKey(seededId(rng));
+        reminder.setName(prefix + QString::number(i % 1000));
+        reminder.setType(Reminder::Type::Daily);
+        reminder.setNextTriggerMinute(baseMinute + 24 * 60 + rng.bounded(24 * 60));
+        reminders.append(reminder);
+    }
+    return reminders;
+}
+
+// 恢复日志级别后把各行结果写入日志
+void logBenchSummaries(const QStringList &summaries)
+{
+    Logger::instance().setMinimumLevel(Logger::LogLevel::Debug);
+    for (const QString &summary : summaries) {
+        LOG_INFO(summary);
+    }
+}
+}
+
+Simulation::Simulation(const Options &options)
+    : m_options(options)
+{
+}
+
+int Simulation::run()
+{
+    QTextStream out(stdout);
+
+    // 模拟数据写入临时数据库，不影响真实的 config.db
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid()) {
+        LOG_ERROR("无法创建模拟用临时目录");
+        return 2;
+    }
+    ConfigManager::setDatabasePath(tempDir.filePath(QStringLiteral("simulation.db")));
+    ConfigManager::instance().setSchedulerBackend(m_options.backend);
+    // 期望值按"错过多次只补发一次"推算
+    ConfigManager::instance().setCatchUpPolicy(QStringLiteral("once"));
+    ConfigManager::instance().setSchedulerHorizonHours(m_options.horizonHours);
+
+    const QDateTime start = toMinutePrecision(QDateTime::currentDateTime());
+    const QDateTime end = start.addDays(m_options.days);
+    // 时间跳变场景：在区间中点把墙上时间拨动 jumpHours 小时（单调时间不变），
+    // 向前拨动的目标不超过模拟结束时间
+    const QDateTime jumpAt = start.addSecs(static_cast<qint64>(m_options.days) * 12 * 3600);
+    const QDateTime jumpTarget = qMin(end, jumpAt.addSecs(static_cast<qint64>(m_options.jumpHours) * 3600));
+    VirtualClock clock(start);
+    Clock::setInstance(&clock);
+
+    // 逐条触发的 INFO 日志会淹没吞吐量，模拟期间只保留警告与错误
+    Logger::instance().setMinimumLevel(Logger::LogLevel::Warning);
+
+    WorkdayCalendar &calendar = WorkdayCalendar::instance();
+
+    QRandomGenerator rng(m_options.seed);
+    QVector<Reminder> reminders;
+    reminders.reserve(m_options.reminderCount);
+    QHash<ReminderId, int> expected;
+    expected.reserve(m_options.reminderCount);
+    qint64 expectedTotal = 0;
+
+    for (int i = 0; i < m_options.reminderCount; ++i) {
+        Reminder reminder;
+        reminder.setKey(seededId(rng));
+        reminder.setName(QString("模拟%1").arg(i));
+        reminder.setPriority(static_cast<Reminder::Priority>(rng.bounded(3)));
+
+        const int roll = rng.bounded(10);
+        const QTime time(rng.bounded(24), rng.bounded(60));
+        if (roll == 0) {
+            // 一次性提醒：落在模拟区间内的任意一分钟
+            reminder.setType(Reminder::Type::Once);
+            reminder.setNextTrigger(start.addSecs(60 * (1 + rng.bounded(m_options.days * 24 * 60))));
+        } else if (roll <= 6) {
+            reminder.setType(Reminder::Type::Daily);
+            QDateTime first(start.date(), time);
+            if (first <= start) {
+                first = first.addDays(1);
+            }
+            reminder.setNextTrigger(first);
+        } else {
+            reminder.setType(Reminder::Type::Workday);
+            QDateTime candidate(start.date(), time);
+            if (candidate <= start) {
+                candidate = candidate.addDays(1);
+            }
+            const QDate firstDate = calendar.nextWorkday(candidate.date(), true);
+            reminder.setNextTrigger(firstDate.isValid() ? QDateTime(firstDate, time) : QDateTime());
+        }
+
+        int count = occurrencesThrough(reminder, end);
+        if (jumpTarget > jumpAt) {
+            // 被跳过的区间内的多次触发合并为一次补发
+            const int skipped = occurrencesThrough(reminder, jumpTarget) - occurrencesThrough(reminder, jumpAt);
+            count -= qMax(0, skipped - 1);
+        }
+        expected.insert(reminder.key(), count);
+        expectedTotal += count;
+        reminders.append(reminder);
+    }
+
+    ReminderManager manager(nullptr, ReminderManager::HorizonPolicy::FromConfig);
+    manager.setManualDispatch(true);
+
+    QHash<ReminderId, int> fired;
+    fired.reserve(m_options.reminderCount);
+    qint64 firedTotal = 0;
+    qint64 maxLatenessMs = 0;
+    // 直接连接：回调在调度线程上执行，此时主线程正阻塞在 processDue() 中
+    QObject::connect(&manager, &ReminderManager::remindersTriggered, &manager,
+                     [&](const QVector<Reminder> &batch) {
+                         const QDateTime now = clock.now();
+                         for (const Reminder &reminder : batch) {
+                             ++fired[reminder.key()];
+                             ++firedTotal;
+                             maxLatenessMs = qMax(maxLatenessMs, reminder.nextTrigger().msecsTo(now));
+                         }
+                     }, Qt::DirectConnection);
+
+    QElapsedTimer timer;
+    timer.start();
+    manager.addReminders(reminders);
+    const qint64 loadMs = timer.restart();
+
+    qint64 steps = 0;
+    qint64 jumpBatch = 0;
+    bool jumped = m_options.jumpHours == 0;
+    for (;;) {
+        const QDateTime next = manager.nextDueTime();
+        if (!jumped && (!next.isValid() || next > jumpAt)) {
+            clock.advance(clock.now().msecsTo(jumpAt));
+            clock.setNow(jumpTarget);
+            const qint64 firedBefore = firedTotal;
+            manager.processDue();
+            jumpBatch = firedTotal - firedBefore;
+            jumped = true;
+            ++steps;
+            continue;
+        }
+        if (!next.isValid() || next > end) {
+            break;
+        }
+        if (next > clock.now()) {
+            clock.advance(clock.now().msecsTo(next));
+        }
+        manager.processDue();
+        ++steps;
+    }
+    const qint64 runMs = timer.restart();
+    manager.saveReminders();
+    const qint64 flushMs = timer.elapsed();
+
+    qint64 missed = 0;
+    qint64 extra = 0;
+    for (auto it = expected.constBegin(); it != expected.constEnd(); ++it) {
+        const int diff = it.value() - fired.value(it.key());
+        if (diff > 0) {
+            missed += diff;
+        } else {
+            extra -= diff;
+        }
+    }
+
+    const quint64 clockJumps = manager.clockJumpCount();
+    Clock::setInstance(nullptr);
+    Logger::instance().setMinimumLevel(Logger::LogLevel::Debug);
+
+    const double seconds = qMax<qint64>(runMs, 1) / 1000.0;
+    const QString summary = QString("模拟完成: 队列=%1, 提醒=%2, 天数=%3, 调度步数=%4, "
+                                    "触发=%5 (期望 %6), 漏触发=%7, 多触发=%8, 最大延迟=%9 ms, "
+                                    "加载 %10 ms, 推进 %11 ms (%12 次/秒), 落盘 %13 ms, 近期窗口 %14 小时")
+        .arg(m_options.backend)
+        .arg(m_options.reminderCount)
+        .arg(m_options.days)
+        .arg(steps)
+        .arg(firedTotal)
+        .arg(expectedTotal)
+        .arg(missed)
+        .arg(extra)
+        .arg(maxLatenessMs)
+        .arg(loadMs)
+        .arg(runMs)
+        .arg(static_cast<qint64>(firedTotal / seconds))
+        .arg(flushMs)
+        .arg(m_options.horizonHours);
+    LOG_INFO(summary);
+    out << summary << Qt::endl;
+
+    bool jumpDetected = true;
+    if (m_options.jumpHours != 0) {
+        jumpDetected = clockJumps > 0;
+        const QString jumpSummary = QString("时间跳变: %1 小时, 检测到 %2 次, 跳变后单轮批量触发 %3 个")
+            .arg(m_options.jumpHours)
+            .arg(clockJumps)
+            .arg(jumpBatch);
+        LOG_INFO(jumpSummary);
+        out << jumpSummary << Qt::endl;
+    }
+
+    return (missed == 0 && extra == 0 && jumpDetected) ? 0 : 1;
+}
+
+int Simulation::benchmarkComparisons(int reminderCount)
+{
+    QTextStream out(stdout);
+    const int count = qMax(1, reminderCount);
+    const QDateTime base = QDateTime::currentDateTime();
+    QRandomGenerator rng(1);
+    QVector<QDateTime> triggers;
+    QVector<qint64> minutes;
+    triggers.reserve(count);
+    minutes.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const QDateTime trigger = base.addSecs(60 * (rng.bounded(2 * 24 * 60) - 24 * 60));
+        triggers.append(trigger);
+        minutes.append(EpochMinute::fromDateTime(trigger));
+    }
+
+    // 每种方式重复多轮，取总耗时折算为单次比较的纳秒数
+    constexpr int kRounds = 20;
+    QElapsedTimer timer;
+    qint64 due = 0;
+
+    // 旧实现：每条提醒都重新读取本地时间并计算 msecsTo
+    timer.start();
+    for (int round = 0; round < kRounds; ++round) {
+        for (const QDateTime &trigger : std::as_const(triggers)) {
+            due += QDateTime::currentDateTime().msecsTo(trigger) <= 0 ? 1 : 0;
+        }
+    }
+    const qint64 perCallNs = timer.nsecsElapsed();
+
+    // 每轮读一次时间，但仍比较 QDateTime
+    timer.restart();
+    for (int round = 0; round < kRounds; ++round) {
+        const QDateTime now = QDateTime::currentDateTime();
+        for (const QDateTime &trigger : std::as_const(triggers)) {
+            due += trigger <= now ? 1 : 0;
+        }
+    }
+    const qint64 dateTimeNs = timer.nsecsElapsed();
+
+    // 当前实现：每轮读一次 UTC 毫秒，比较纪元分钟
+    timer.restart();
+    for (int round = 0; round < kRounds; ++round) {
+        const qint64 nowMinute = EpochMinute::fromMSecs(QDateTime::currentMSecsSinceEpoch());
+        for (qint64 minute : std::as_const(minutes)) {
+            due += minute <= nowMinute ? 1 : 0;
+        }
+    }
+    const qint64 epochNs = timer.nsecsElapsed();
+
+    const double comparisons = static_cast<double>(count) * kRounds;
+    const QString summary = QString("单次触发比较耗时 (%1 条 x %2 轮): "
+                                    "逐条取时间+msecsTo %3 ns, QDateTime 比较 %4 ns, 纪元分钟 %5 ns (校验和 %6)")
+        .arg(count)
+        .arg(kRounds)
+        .arg(perCallNs / comparisons, 0, 'f', 2)
+        .arg(dateTimeNs / comparisons, 0, 'f', 2)
+        .arg(epochNs / comparisons, 0, 'f', 2)
+        .arg(due);
+    LOG_INFO(summary);
+    out << summary << Qt::endl;
+    return 0;
+}
+
+int Simulation::benchmarkMemory(int reminderCount)
+{
+    QTextStream out(stdout);
+    const int count = qMax(1, reminderCount);
+    // 名称从 1000 个常见名称中选取，模拟大量提醒名称重复的情况
+    constexpr int kDistinctNames = 1000;
+    QRandomGenerator rng(1);
+    const qint64 baseMinute = EpochMinute::fromMSecs(QDateTime::currentMSecsSinceEpoch());
+
+    // 紧凑表示：存储（数组 + 索引）与堆队列分别计量
+    qint64 before = residentBytes();
+    ReminderStore store;
+    store.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        Reminder reminder;
+        reminder.setKey(seededId(rng));
+        reminder.setName(QString("提醒%1").arg(i % kDistinctNames));
+        reminder.setType(static_cast<Reminder::Type>(rng.bounded(3)));
+        reminder.setPriority(static_cast<Reminder::Priority>(rng.bounded(3)));
+        reminder.setNextTriggerMinute(baseMinute + rng.bounded(365 * 24 * 60));
+        store.insert(reminder);
+    }
+    const qint64 storeBytes = residentBytes() - before;
+
+    before = residentBytes();
+    std::unique_ptr<TriggerQueue> queue = TriggerQueue::create(TriggerQueue::Backend::Heap, baseMinute);
+    for (const Reminder &reminder : store.items()) {
+        queue->schedule(reminder.key(), reminder.nextTriggerMinute());
+    }
+    const qint64 queueBytes = residentBytes() - before;
+
+    // 旧布局对照：两个 QString 成员（名称、36 字符的 ID 字符串）加枚举与布尔字段，
+    // 索引以 ID 字符串为键
+    struct LegacyReminder {
+        QString name;
+        Reminder::Type type;
+        qint64 nextTriggerMinute;
+        QString id;
+        bool completed;
+        Reminder::Priority priority;
+    };
+    before = residentBytes();
+    QVector<LegacyReminder> legacyItems;
+    QHash<QString, int> legacySlots;
+    legacyItems.reserve(count);
+    legacySlots.reserve(count);
+    for (const Reminder &reminder : store.items()) {
+        // 逐条构造字符串，与从数据库逐行读出时一样各自持有一份数据
+        LegacyReminder legacy{QString("提醒%1").arg(legacyItems.size() % kDistinctNames),
+                              reminder.type(), reminder.nextTriggerMinute(), reminder.id(),
+                              reminder.completed(), reminder.priority()};
+        legacySlots.insert(legacy.id, legacyItems.size());
+        legacyItems.append(legacy);
+    }
+    const qint64 legacyBytes = residentBytes() - before;
+
+    if (storeBytes < 0 || legacyBytes < 0) {
+        out << "当前平台无法读取常驻内存，只报告结构体大小: sizeof(Reminder)="
+            << sizeof(Reminder) << ", 旧布局 " << sizeof(LegacyReminder) << Qt::endl;
+        return 0;
+    }
+
+    const QString summary = QString("内存占用 (%1 条提醒, %2 个不同名称): "
+                                    "sizeof(Reminder)=%3 B, 存储 %4 B/条, 堆队列 %5 B/条, "
+                                    "名称池 %6 KB; 旧布局 sizeof=%7 B, 存储 %8 B/条 (%9 MB -> %10 MB)")
+        .arg(count)
+        .arg(NamePool::instance().size() - 1)
+        .arg(sizeof(Reminder))
+        .arg(static_cast<double>(storeBytes) / count, 0, 'f', 1)
+        .arg(static_cast<double>(queueBytes) / count, 0, 'f', 1)
+        .arg(NamePool::instance().approximateBytes() / 1024)
+        .arg(sizeof(LegacyReminder))
+        .arg(static_cast<double>(legacyBytes) / count, 0, 'f', 1)
+        .arg(legacyBytes / (1024 * 1024))
+        .arg(storeBytes / (1024 * 1024));
+    LOG_INFO(summary);
+    out << summary << Qt::endl;
+    return 0;
+}
+
+int Simulation::benchmarkScan()
+{
+    QTextStream out(stdout);
+    const QVector<int> sizes = {10000, 100000, 1000000};
+    const qint64 baseMinute = EpochMinute::fromMSecs(QDateTime::currentMSecsSinceEpoch());
+    // 触发时间分布在一年内，now 取在约 1% 的提醒已到期的位置
+    const qint64 spanMinutes = 365 * 24 * 60;
+    const qint64 nowMinute = baseMinute + spanMinutes / 100;
+    int result = 0;
+
+    out << "到期扫描内核: " << DueScan::kernelName(DueScan::activeKernel()) << Qt::endl;
+    for (int count : sizes) {
+        QRandomGenerator rng(1);
+        QVector<Reminder> reminders;
+        QHash<ReminderId, qint64> hashed;
+        QVector<qint64> minutes;
+        reminders.reserve(count);
+        hashed.reserve(count);
+        minutes.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            Reminder reminder;
+            reminder.setKey(seededId(rng));
+            reminder.setNextTriggerMinute(baseMinute + rng.bounded(spanMinutes));
+            reminders.append(reminder);
+            hashed.insert(reminder.key(), reminder.nextTriggerMinute());
+            minutes.append(reminder.nextTriggerMinute());
+        }
+
+        // 每种方式扫描总量约 2000 万条，折算为每条的纳秒数
+        const int rounds = qMax(5, 20000000 / count);
+        QElapsedTimer timer;
+        QVector<int> due;
+        due.reserve(count);
+
+        // 结构体数组：逐条把整个 Reminder 读入缓存，只为比较一个时间
+        qint64 aosDue = 0;
+        timer.start();
+        for (int round = 0; round < rounds; ++round) {
+            due.clear();
+            for (int i = 0; i < reminders.size(); ++i) {
+                const Reminder &reminder = reminders.at(i);
+                if (!reminder.completed() && reminder.nextTriggerMinute() <= nowMinute) {
+                    due.append(i);
+                }
+            }
+            aosDue += due.size();
+        }
+        const qint64 aosNs = timer.nsecsElapsed();
+
+        // 原线性队列：遍历 id -> 分钟的哈希表
+        qint64 hashDue = 0;
+        timer.restart();
+        for (int round = 0; round < rounds; ++round) {
+            due.clear();
+            int index = 0;
+            for (auto it = hashed.constBegin(); it != hashed.constEnd(); ++it, ++index) {
+                if (it.value() <= nowMinute) {
+                    due.append(index);
+                }
+            }
+            hashDue += due.size();
+        }
+        const qint64 hashNs = timer.nsecsElapsed();
+
+        // 分列存放的分钟数组，依次使用各个可用的内核
+        QStringList kernelResults;
+        for (DueScan::Kernel kernel : {DueScan::Kernel::Scalar, DueScan::Kernel::Sse42, DueScan::Kernel::Avx2}) {
+            if (!DueScan::isSupported(kernel)) {
+                continue;
+            }
+            qint64 kernelDue = 0;
+            timer.restart();
+            for (int round = 0; round < rounds; ++round) {
+                due.clear();
+                DueScan::collect(kernel, minutes.constData(), minutes.size(), nowMinute, due);
+                kernelDue += due.size();
+            }
+            const qint64 kernelNs = timer.nsecsElapsed();
+            if (kernelDue != aosDue) {
+                result = 1;
+            }
+            kernelResults.append(QString("%1 %2 ns")
+                .arg(DueScan::kernelName(kernel))
+                .arg(static_cast<double>(kernelNs) / rounds / count, 0, 'f', 3));
+        }
+        if (hashDue != aosDue) {
+            result = 1;
+        }
+
+        const QString summary = QString("到期扫描 (%1 条 x %2 轮, 每轮到期 %3 条): "
+                                        "结构体数组 %4 ns, 哈希表 %5 ns, 分列 %6 (每条)")
+            .arg(count)
+            .arg(rounds)
+            .arg(aosDue / rounds)
+            .arg(static_cast<double>(aosNs) / rounds / count, 0, 'f', 3)
+            .arg(static_cast<double>(hashNs) / rounds / count, 0, 'f', 3)
+            .arg(kernelResults.join(QStringLiteral(", ")));
+        LOG_INFO(summary);
+        out << summary << Qt::endl;
+    }
+    if (result != 0) {
+        LOG_ERROR("到期扫描内核的结果与逐条比较不一致");
+    }
+    return result;
+}
+
+int Simulation::benchmarkStore(int reminderCount)
+{
+    QTextStream out(stdout);
+    QTemporaryDir tempDir;
+    if (!prepareBenchDatabase(tempDir, QStringLiteral("store.db"))) {
+        return 2;
+    }
+
+    const int count = qMax(1000, reminderCount);
+    const QVector<Reminder> reminders = seededFutureReminders(
+        count, QStringLiteral("存储"), EpochMinute::fromMSecs(QDateTime::currentMSecsSinceEpoch()));
+    // 按打乱后的顺序删除，避免总是删掉末尾元素而测不出中间删除的开销
+    QRandomGenerator rng(2);
+    QVector<Reminder> removalOrder = reminders;
+    for (int i = removalOrder.size() - 1; i > 0; --i) {
+        std::swap(removalOrder[i], removalOrder[rng.bounded(i + 1)]);
+    }
+    QStringList removalIds;
+    removalIds.reserve(count);
+    for (const Reminder &reminder : std::as_const(removalOrder)) {
+        removalIds.append(reminder.id());
+    }
+
+    int leftovers = 0;
+    QElapsedTimer timer;
+
+    ReminderStore store;
+    timer.start();
+    for (const Reminder &reminder : std::as_const(reminders)) {
+        store.insert(reminder);
+    }
+    const qint64 storeInsertUs = timer.nsecsElapsed() / 1000;
+    timer.restart();
+    for (const Reminder &reminder : std::as_const(removalOrder)) {
+        store.remove(reminder.key());
+    }
+    const qint64 storeRemoveUs = timer.nsecsElapsed() / 1000;
+    leftovers += store.size();
+
+    // 调度器的耗时包含分片加锁、到期队列维护、变更通知和写后日志记录，落盘另行同步等待
+    qint64 singleAddUs = 0;
+    qint64 singleDeleteUs = 0;
+    qint64 batchAddUs = 0;
+    qint64 batchDeleteUs = 0;
+    {
+        ReminderManager manager;
+        manager.setManualDispatch(true);
+        timer.restart();
+        for (const Reminder &reminder : std::as_const(reminders)) {
+            manager.addReminder(reminder);
+        }
+        singleAddUs = timer.nsecsElapsed() / 1000;
+        manager.saveReminders();
+        timer.restart();
+        for (const Reminder &reminder : std::as_const(removalOrder)) {
+            manager.deleteReminder(reminder);
+        }
+        singleDeleteUs = timer.nsecsElapsed() / 1000;
+        manager.saveReminders();
+        leftovers += manager.getReminders().size();
+
+        timer.restart();
+        manager.addReminders(reminders);
+        batchAddUs = timer.nsecsElapsed() / 1000;
+        manager.saveReminders();
+        timer.restart();
+        manager.deleteReminders(removalIds);
+        batchDeleteUs = timer.nsecsElapsed() / 1000;
+        manager.saveReminders();
+        leftovers += manager.getReminders().size();
+    }
+
+    auto perItem = [count](qint64 us) {
+        return QString::number(static_cast<double>(us) * 1000.0 / count, 'f', 0);
+    };
+    const QStringList summaries = {
+        QString("ReminderStore %1 条: 插入 %2 ns/条, 删除 %3 ns/条")
+            .arg(count).arg(perItem(storeInsertUs)).arg(perItem(storeRemoveUs)),
+        QString("ReminderManager 逐条 %1 条: 添加 %2 ns/条, 删除 %3 ns/条")
+            .arg(count).arg(perItem(singleAddUs)).arg(perItem(singleDeleteUs)),
+        QString("ReminderManager 整批 %1 条: 添加 %2 ns/条, 删除 %3 ns/条")
+            .arg(count).arg(perItem(batchAddUs)).arg(perItem(batchDeleteUs)),
+    };
+    for (const QString &summary : summaries) {
+        out << summary << Qt::endl;
+    }
+
+    logBenchSummaries(summaries);
+    if (leftovers != 0) {
+        LOG_ERROR(QString("删除后仍残留 %1 条提醒").arg(leftovers));
+        return 1;
+    }
+    return 0;
+}
+
+int Simulation::benchmarkContention(int reminderCount)
+{
+    QTextStream out(stdout);
+    QTemporaryDir tempDir;
+    if (!prepareBenchDatabase(tempDir, QStringLiteral("contention.db"))) {
+        return 2;
+    }
+
+    const int count = qMax(1000, reminderCount);
+    const QVector<Reminder> reminders = seededFutureReminders(
+        count, QStringLiteral("并发"), EpochMinute::fromMSecs(QDateTime::currentMSecsSinceEpoch()));
+
+    ReminderManager manager;
+    manager.setManualDispatch(true);
+    manager.addReminders(reminders);
+    manager.saveReminders();
+
+    // 每个写线程只修改自己那一段提醒，互相之间没有逻辑冲突，吞吐量只受锁竞争限制
+    constexpr int kDurationMs = 1000;
+    const int maxThreads = qMax(4, QThread::idealThreadCount());
+    double singleThreadRate = 0;
+    QStringList summaries;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        std::atomic<bool> stop(false);
+        std::atomic<qint64> operations(0);
+        QVector<QThread *> workers;
+        for (int t = 0; t < threads; ++t) {
+            const int begin = static_cast<int>(static_cast<qint64>(count) * t / threads);
+            const int end = static_cast<int>(static_cast<qint64>(count) * (t + 1) / threads);
+            workers.append(QThread::create([&, begin, end]() {
+                qint64 done = 0;
+                for (int i = begin; !stop.load(std::memory_order_relaxed); ++i) {
+                    if (i >= end) {
+                        i = begin;
+                    }
+                    Reminder reminder = reminders.at(i);
+                    reminder.setNextTriggerMinute(reminder.nextTriggerMinute() + (done & 1));
+                    manager.updateReminder(reminder);
+                    ++done;
+                }
+                operations.fetch_add(done);
+            }));
+        }
+        QElapsedTimer timer;
+        timer.start();
+        for (QThread *worker : std::as_const(workers)) {
+            worker->start();
+        }
+        QThread::msleep(kDurationMs);
+        stop.store(true);
+        for (QThread *worker : std::as_const(workers)) {
+            worker->wait();
+            delete worker;
+        }
+        const double rate = operations.load() * 1000.0 / qMax<qint64>(timer.elapsed(), 1);
+        if (threads == 1) {
+            singleThreadRate = rate;
+        }
+        const QString summary = QString("并发更新 (%1 条提醒, %2 个写线程): %3 次/秒, 相对单线程 %4x")
+            .arg(count)
+            .arg(threads)
+            .arg(static_cast<qint64>(rate))
+            .arg(singleThreadRate > 0 ? rate / singleThreadRate : 0.0, 0, 'f', 2);
+        summaries.append(summary);
+        out << summary << Qt::endl;
+    }
+
+    manager.saveReminders();
+    logBenchSummaries(summaries);
+    return 0;
+}
+
+int Simulation::benchmarkPersist(int reminderCount)
+{
+    QTextStream out(stdout);
+    QTemporaryDir tempDir;
+    if (!prepareBenchDatabase(tempDir, QStringLiteral("persist.db"))) {
+        return 2;
+    }
+    ConfigManager &config = ConfigManager::instance();
+
+    // 每种规模修改同样多次，每次修改后立即同步落盘，测得的是单次修改的完整持久化开销
+    constexpr int kMutations = 200;
+    const int maxCount = qMax(100, reminderCount);
+    const qint64 baseMinute = EpochMinute::fromMSecs(QDateTime::currentMSecsSinceEpoch());
+    QStringList summaries;
+    for (int count = 100; count <= maxCount; count *= 10) {
+        config.setReminders(QVector<Reminder>());
+        const QVector<Reminder> reminders = seededFutureReminders(count, QStringLiteral("持久化"), baseMinute);
+        QRandomGenerator rng(2);
+
+        qint64 mutationUs = 0;
+        {
+            ReminderManager manager;
+            manager.setManualDispatch(true);
+            manager.addReminders(reminders);
+            manager.saveReminders();
+
+            QElapsedTimer timer;
+            timer.start();
+            for (int i = 0; i < kMutations; ++i) {
+                Reminder reminder = reminders.at(rng.bounded(count));
+                reminder.setName(QString("修改%1").arg(i));
+                manager.updateReminder(reminder);
+                manager.saveReminders();
+            }
+            mutationUs = timer.nsecsElapsed() / 1000;
+        }
+
+        // 对照：旧实现每次修改都整表删除后重新插入
+        QElapsedTimer timer;
+        timer.start();
+        config.setReminders(reminders);
+        const qint64 rewriteUs = timer.nsecsElapsed() / 1000;
+
+        const QString summary = QString("表中 %1 条提醒: 增量落盘 %2 us/次, 整表重写 %3 us/次")
+            .arg(count, 6)
+            .arg(static_cast<double>(mutationUs) / kMutations, 0, 'f', 1)
+            .arg(rewriteUs);
+        summaries.append(summary);
+        out << summary << Qt::endl;
+    }
+
+    logBenchSummaries(summaries);
+    return 0;
+}
+
+int Simulation::benchmarkBurst(int reminderCount)
+{
+    QTextStream out(stdout);
+    QTemporaryDir tempDir;
+    if (!prepareBenchDatabase(tempDir, QStringLiteral("burst.db"))) {
+        return 2;
+    }
+    ConfigManager::instance().setCatchUpPolicy(QStringLiteral("once"));
+
+    // 全部设为下一个工作日 09:00 的工作日提醒：触发后又会落在同一分钟，可以连测两轮
+    WorkdayCalendar &calendar = WorkdayCalendar::instance();
+    const QDate firstDay = calendar.nextWorkday(QDate::currentDate().addDays(1), true);
+    const QDateTime due(firstDay.isValid() ? firstDay : QDate::currentDate().addDays(1), QTime(9, 0));
+    VirtualClock clock(due.addSecs(-60));
+    Clock::setInstance(&clock);
+
+    const int count = qMax(1, reminderCount);
+    QRandomGenerator rng(1);
+    QVector<Reminder> reminders;
+    reminders.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        Reminder reminder;
+        reminder.setKey(seededId(rng));
+        reminder.setName(QString("晨会%1").arg(i % 1000));
+        reminder.setType(Reminder::Type::Workday);
+        reminder.setPriority(static_cast<Reminder::Priority>(rng.bounded(3)));
+        reminder.setNextTrigger(due);
+        reminders.append(reminder);
+    }
+
+    int result = 0;
+    QStringList summaries;
+    {
+        ReminderManager manager;
+        manager.setManualDispatch(true);
+        manager.addReminders(reminders);
+        manager.saveReminders();
+
+        qint64 fired = 0;
+        int batches = 0;
+        // 直接连接：回调在调度线程上执行，计入排空时间
+        QObject::connect(&manager, &ReminderManager::remindersTriggered, &manager,
+                         [&](const QVector<Reminder> &batch) {
+                             fired += batch.size();
+                             ++batches;
+                         }, Qt::DirectConnection);
+
+        const struct {
+            const char *label;
+            int threshold;
+        } rounds[] = {
+            {"逐条推算", std::numeric_limits<int>::max()},
+            {"并行推算", 1},
+        };
+        for (const auto &round : rounds) {
+            manager.setBurstThreshold(round.threshold);
+            const QDateTime next = manager.nextDueTime();
+            if (next.isValid() && next > clock.now()) {
+                clock.advance(clock.now().msecsTo(next));
+            }
+            fired = 0;
+            batches = 0;
+            QElapsedTimer timer;
+            timer.start();
+            manager.processDue();
+            const qint64 drainUs = timer.nsecsElapsed() / 1000;
+            timer.restart();
+            manager.saveReminders();
+            const qint64 flushMs = timer.elapsed();
+            if (fired != count) {
+                result = 1;
+            }
+            const QString summary = QString("同时到期 %1 个提醒 (%2, %3 线程): 排空 %4 ms (%5 us/条), "
+                                            "触发 %6 个 / %7 次信号, 落盘 %8 ms")
+                .arg(count)
+                .arg(QString::fromUtf8(round.label))
+                .arg(round.threshold == 1 ? QThreadPool::globalInstance()->maxThreadCount() : 1)
+                .arg(drainUs / 1000.0, 0, 'f', 1)
+                .arg(static_cast<double>(drainUs) / count, 0, 'f', 2)
+                .arg(fired)
+                .arg(batches)
+                .arg(flushMs);
+            summaries.append(summary);
+            out << summary << Qt::endl;
+        }
+    }
+
+    Clock::setInstance(nullptr);
+    logBenchSummaries(summaries);
+    return result;
+}
+
+int Simulation::benchmarkDatabase(int reminderCount)
+{
+    QTextStream out(stdout);
+    QTemporaryDir tempDir;
+    // 临时库与真实数据在同一类磁盘上时，durable/legacy 的结果才有参考意义
+    if (!prepareBenchDatabase(tempDir, QStringLiteral("profiles.db"))) {
+        return 2;
+    }
+    ConfigManager &config = ConfigManager::instance();
+
+    const int count = qMax(100, reminderCount);
+    const int singles = qMin(count, 500);
+    const QVector<Reminder> batch = seededFutureReminders(
+        count, QStringLiteral("写入"), EpochMinute::fromMSecs(QDateTime::currentMSecsSinceEpoch()));
+
+    int result = 0;
+    QStringList summaries;
+    const QString original = config.dbProfile();
+    for (const QString &profile : ConfigManager::dbProfiles()) {
+        config.setDbProfile(profile);
+        config.setReminders(QVector<Reminder>());
+
+        // 逐条提交：每次一个事务，主要受 fsync 次数限制
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < singles; ++i) {
+            if (!config.applyReminderChanges(QVector<Reminder>{batch.at(i)}, QStringList())) {
+                result = 1;
+            }
+        }
+        const qint64 singleUs = qMax<qint64>(timer.nsecsElapsed() / 1000, 1);
+
+        // 整批：一个事务内写入全部提醒，主要受语句执行与页缓存影响
+        timer.restart();
+        if (!config.applyReminderChanges(batch, QStringList())) {
+            result = 1;
+        }
+        const qint64 batchUs = qMax<qint64>(timer.nsecsElapsed() / 1000, 1);
+
+        const QString summary = QString("数据库档位 %1: 逐条提交 %2 次/秒 (%3 次), 整批写入 %4 行/秒 (%5 行)")
+            .arg(profile, -8)
+            .arg(static_cast<qint64>(singles * 1000000.0 / singleUs))
+            .arg(singles)
+            .arg(static_cast<qint64>(count * 1000000.0 / batchUs))
+            .arg(count);
+        summaries.append(summary);
+        out << summary << Qt::endl;
+    }
+    config.setDbProfile(original);
+    // 临时库随函数返回删除，先把异步写入的设置落盘
+    config.flushSettings();
+
+    logBenchSummaries(summaries);
+    return result;
+}
+
+int Simulation::benchmarkCodec(int reminderCount)
+{
+    QTextStream out(stdout);
+    QTemporaryDir tempDir;
+    if (!prepareBenchDatabase(tempDir, QStringLiteral("codec.db"))) {
+        return 2;
+    }
+    // 独立连接与独立的库文件。JSON 往返按旧表结构（ISO 文本时间）读写，
+    // 行编解码按当前表结构（纪元分钟整数 + 到期索引）读写，与 ConfigManager 中的两个版本一致
+    const QString connection = QStringLiteral("codec_bench");
+    int result = 0;
+    QStringList summaries;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), connection);
+        db.setDatabaseName(tempDir.filePath(QStringLiteral("codec.db")));
+        if (!db.open()) {
+            LOG_ERROR(QString("无法打开基准测试数据库: %1").arg(db.lastError().text()));
+            return 2;
+        }
+        QSqlQuery ddl(db);
+        ddl.exec(QStringLiteral("PRAGMA journal_mode=WAL"));
+        ddl.exec(QStringLiteral("PRAGMA synchronous=NORMAL"));
+        ddl.exec(QStringLiteral("CREATE TABLE reminders (id TEXT PRIMARY KEY, name TEXT, type INTEGER, "
+                                "priority INTEGER, next_trigger TEXT, completed INTEGER)"));
+        ddl.exec(QStringLiteral("CREATE TABLE reminders_v2 (id TEXT PRIMARY KEY, name TEXT, type INTEGER NOT NULL, "
+                                "priority INTEGER NOT NULL, next_trigger INTEGER, completed INTEGER NOT NULL)"));
+        ddl.exec(QStringLiteral("CREATE INDEX reminders_v2_due ON reminders_v2 (completed, next_trigger)"));
+
+        const int count = qMax(1000, reminderCount);
+        QVector<Reminder> reminders = seededFutureReminders(
+            count, QStringLiteral("行"), EpochMinute::fromMSecs(QDateTime::currentMSecsSinceEpoch()));
+        // 混入工作日提醒，类型列的两种取值都走一遍编解码
+        for (int i = 0; i < count; i += 3) {
+            reminders[i].setType(Reminder::Type::Workday);
+        }
+        const QString jsonInsertSql = QString("INSERT INTO reminders (%1) VALUES (?, ?, ?, ?, ?, ?)")
+            .arg(ReminderRowCodec::columns());
+        const QString jsonSelectSql = QString("SELECT %1 FROM reminders").arg(ReminderRowCodec::columns());
+        const QString rowInsertSql = QString("INSERT INTO reminders_v2 (%1) VALUES (?, ?, ?, ?, ?, ?)")
+            .arg(ReminderRowCodec::columns());
+        const QString rowSelectSql = QString("SELECT %1 FROM reminders_v2").arg(ReminderRowCodec::columns());
+
+        auto clearTable = [&db]() {
+            QSqlQuery query(db);
+            query.exec(QStringLiteral("DELETE FROM reminders"));
+            query.exec(QStringLiteral("DELETE FROM reminders_v2"));
+        };
+
+        // 旧路径：Reminder -> QJsonObject -> QJsonArray -> 去重复制 -> 按键取值绑定
+        auto saveJson = [&]() {
+            QJsonArray array;
+            for (const Reminder &reminder : std::as_const(reminders)) {
+                array.append(reminder.toJson());
+            }
+            QSet<QString> ids;
+            QJsonArray unique;
+            for (const QJsonValue &val : std::as_const(array)) {
+                const QJsonObject obj = val.toObject();
+                const QString id = obj.value("id").toString();
+                if (ids.contains(id))
+                    continue;
+                ids.insert(id);
+                unique.append(obj);
+            }
+            db.transaction();
+            QSqlQuery query(db);
+            query.prepare(jsonInsertSql);
+            for (const QJsonValue &val : std::as_const(unique)) {
+                const QJsonObject obj = val.toObject();
+                query.addBindValue(obj.value("id").toString());
+                query.addBindValue(obj.value("name").toString());
+                query.addBindValue(obj.value("type").toInt());
+                query.addBindValue(obj.value("priority").toInt());
+                query.addBindValue(obj.value("nextTrigger").toString());
+                query.addBindValue(obj.value("completed").toBool() ? 1 : 0);
+                if (!query.exec())
+                    result = 1;
+            }
+            db.commit();
+        };
+        // 旧路径：逐行填 QJsonObject 放入 QJsonArray，再逐个 fromJson
+        auto loadJson = [&]() {
+            QJsonArray array;
+            QSqlQuery query(db);
+            query.exec(jsonSelectSql);
+            while (query.next()) {
+                QJsonObject obj;
+                obj["id"] = query.value(0).toString();
+                obj["name"] = query.value(1).toString();
+                obj["type"] = query.value(2).toInt();
+                obj["priority"] = query.value(3).toInt();
+                obj["nextTrigger"] = query.value(4).toString();
+                obj["completed"] = query.value(5).toBool();
+                array.append(obj);
+            }
+            QVector<Reminder> loaded;
+            loaded.reserve(array.size());
+            for (const QJsonValue &val : std::as_const(array)) {
+                loaded.append(Reminder::fromJson(val.toObject()));
+            }
+            return loaded;
+        };
+        auto saveRows = [&]() {
+            db.transaction();
+            QSqlQuery query(db);
+            query.prepare(rowInsertSql);
+            for (const Reminder &reminder : std::as_const(reminders)) {
+                ReminderRowCodec::bind(query, reminder);
+                if (!query.exec())
+                    result = 1;
+            }
+            db.commit();
+        };
+        auto loadRows = [&]() {
+            QVector<Reminder> loaded;
+            loaded.reserve(count);
+            QSqlQuery query(db);
+            query.setForwardOnly(true);
+            query.exec(rowSelectSql);
+            while (query.next()) {
+                loaded.append(ReminderRowCodec::read(query));
+            }
+            return loaded;
+        };
+
+        QElapsedTimer timer;
+        clearTable();
+        timer.start();
+        saveJson();
+        const qint64 saveJsonUs = qMax<qint64>(timer.nsecsElapsed() / 1000, 1);
+        timer.restart();
+        const QVector<Reminder> fromJson = loadJson();
+        const qint64 loadJsonUs = qMax<qint64>(timer.nsecsElapsed() / 1000, 1);
+
+        clearTable();
+        timer.restart();
+        saveRows();
+        const qint64 saveRowsUs = qMax<qint64>(timer.nsecsElapsed() / 1000, 1);
+        timer.restart();
+        const QVector<Reminder> fromRows = loadRows();
+        const qint64 loadRowsUs = qMax<qint64>(timer.nsecsElapsed() / 1000, 1);
+
+        // 两条路径写入并读回的内容必须一致
+        if (fromJson.size() != count || fromRows.size() != count) {
+            result = 1;
+        } else {
+            for (int i = 0; i < count; ++i) {
+                if (fromJson.at(i) != fromRows.at(i)) {
+                    result = 1;
+                    break;
+                }
+            }
+        }
+
+        auto line = [count](const QString &label, qint64 jsonUs, qint64 rowsUs) {
+            return QString("%1 %2 行: JSON 往返 %3 ms, 行编解码 %4 ms, 加速 %5x")
+                .arg(label)
+                .arg(count)
+                .arg(jsonUs / 1000.0, 0, 'f', 1)
+                .arg(rowsUs / 1000.0, 0, 'f', 1)
+                .arg(static_cast<double>(jsonUs) / rowsUs, 0, 'f', 2);
+        };
+        summaries.append(line(QStringLiteral("保存"), saveJsonUs, saveRowsUs));
+        summaries.append(line(QStringLiteral("加载"), loadJsonUs, loadRowsUs));
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(connection);
+
+    for (const QString &summary : std::as_const(summaries)) {
+        out << summary << Qt::endl;
+    }
+    logBenchSummaries(summaries);
+    if (result != 0) {
+        LOG_ERROR("两种路径读回的提醒不一致或写入失败");
+    }
+    return result;
+}
+
+int Simulation::benchmarkHorizon(int reminderCount)
+{
+    QTextStream out(stdout);
+    QTemporaryDir tempDir;
+    if (!prepareBenchDatabase(tempDir, QStringLiteral("horizon.db"))) {
+        return 2;
+    }
+    ConfigManager &config = ConfigManager::instance();
+
+    // 八成是已完成的历史提醒，其余的下次触发时间均匀分布在未来一年内
+    const int count = qMax(1000, reminderCount);
+    const qint64 nowMinute = EpochMinute::fromMSecs(QDateTime::currentMSecsSinceEpoch());
+    constexpr qint64 kYearMinutes = 365ll * 24 * 60;
+    QRandomGenerator rng(1);
+    QVector<Reminder> reminders;
+    reminders.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        Reminder reminder;
+        reminder.setKey(seededId(rng));
+        reminder.setName(QString("历史%1").arg(i % 1000));
+        if (rng.bounded(5) != 0) {
+            reminder.setType(Reminder::Type::Once);
+            reminder.setCompleted(true);
+            reminder.setNextTriggerMinute(nowMinute - 1 - static_cast<qint64>(rng.bounded(static_cast<quint32>(kYearMinutes))));
+        } else {
+            reminder.setType(rng.bounded(2) ? Reminder::Type::Daily : Reminder::Type::Once);
+            reminder.setNextTriggerMinute(nowMinute + 1 + static_cast<qint64>(rng.bounded(static_cast<quint32>(kYearMinutes))));
+        }
+        reminders.append(reminder);
+    }
+    config.setReminders(reminders);
+    reminders.clear();
+    reminders.squeeze();
+
+    int result = 0;
+    int fullResident = -1;
+    QStringList summaries;
+    const int original = config.schedulerHorizonHours();
+    for (const int hours : {0, 24}) {
+        config.setSchedulerHorizonHours(hours);
+        const qint64 before = residentBytes();
+        QElapsedTimer timer;
+        timer.start();
+        ReminderManager manager(nullptr, ReminderManager::HorizonPolicy::FromConfig);
+        const qint64 startupMs = timer.elapsed();
+        const qint64 after = residentBytes();
+        const int resident = manager.getReminders().size();
+        if (hours == 0) {
+            fullResident = resident;
+        } else if (resident > fullResident) {
+            result = 1;
+        }
+        const QString summary = QString("近期窗口 %1 小时: 启动加载 %2 ms, 内存中 %3 / %4 个提醒, 常驻内存增量 %5")
+            .arg(hours, 2)
+            .arg(startupMs)
+            .arg(resident)
+            .arg(count)
+            .arg(before >= 0 && after >= 0 ? QString("%1 KiB").arg((after - before) / 1024) : QStringLiteral("未知"));
+        summaries.append(summary);
+        out << summary << Qt::endl;
+    }
+    config.setSchedulerHorizonHours(original);
+    // 临时库随函数返回删除，先把异步写入的设置落盘
+    config.flushSettings();
+
+    logBenchSummaries(summaries);
+    return result;
+}
@@ -0,0 +1,64 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <QString>
+
+// 时间快进模拟：在临时数据库中生成一批提醒，用虚拟时钟驱动真实的
+// ReminderManager 与工作日日历，尽可能快地推进若干天，统计吞吐量并
+// 核对每个提醒的触发次数是否与独立推算的期望值一致。
+class Simulation
+{
+public:
+    struct Options {
+        int reminderCount = 100000;
+        int days = 365;
+        QString backend = QStringLiteral("heap");
+        quint32 seed = 1;
+        // 非 0 时在区间中点把墙上时间拨动该小时数，检验时间跳变检测与批量补发
+        int jumpHours = 0;
+        // 大于 0 时以该近期窗口（小时）运行调度器，检验窗口滑动调入与移出
+        int horizonHours = 0;
+    };
+
+    explicit Simulation(const Options &options);
+
+    // 返回 0 表示没有漏触发或多触发
+    int run();
+
+    // 触发判断的单次比较开销：逐条取本地时间的 QDateTime 比较 vs. 纪元分钟整数比较
+    static int benchmarkComparisons(int reminderCount);
+
+    // 大规模提醒集合的常驻内存：紧凑表示（存储 + 堆队列）与旧的 QString 布局对照
+    static int benchmarkMemory(int reminderCount);
+
+    // 线性扫描在 1 万/10 万/100 万条时的到期判断开销：结构体数组逐条比较、
+    // 原哈希表遍历与分列存放 + 向量化内核；各方式结果不一致时返回非 0
+    static int benchmarkScan();
+
+    // 按 ID 索引的存储与调度器在 10 万条规模下的增删耗时：逐条与整批各测一轮；删除后有残留时返回非 0
+    static int benchmarkStore(int reminderCount);
+
+    // 1/2/4/... 个写线程同时更新各自的一段提醒时的吞吐量，用于观察分片锁的扩展性
+    static int benchmarkContention(int reminderCount);
+
+    // 表中分别有 100、1000、1 万……条提醒时，修改一条并落盘的耗时（增量写入）与整表重写的耗时
+    static int benchmarkPersist(int reminderCount);
+
+    // 同一分钟到期的大批工作日提醒从调度检查开始到全部发出、推算完毕所需的时间，
+    // 逐条推算与线程池并行推算各测一轮；未全部触发时返回非 0
+    static int benchmarkBurst(int reminderCount);
+
+    // 各数据库档位下的写入速度：逐条提交（写后日志的常见情形）与整批一个事务
+    static int benchmarkDatabase(int reminderCount);
+
+    // 保存与加载整张提醒表：旧的 QJsonArray 往返与直接的行编解码对照；读回内容不一致时返回非 0
+    static int benchmarkCodec(int reminderCount);
+
+    // 数据库中以已完成历史为主的大量提醒：全部加载与近期窗口模式下的启动耗时与内存中提醒数
+    static int benchmarkHorizon(int reminderCount);
+
+private:
+    Options m_options;
+};
+
+#endif // SIMULATION_H
@@ -2,6 +2,8 @@
 #define ACTIVE_REMINDERTABLEMODEL_H
 
 #include <QAbstractTableModel>
+#include <QHash>
+#include <QSet>
 #include <QVector>
 #include "core/reminders/reminder.h"
 
@@ -20,27 +22,27 @@ public:
     bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
     Qt::ItemFlags flags(const QModelIndex &index) const override;
 
-    // 提醒管理函数
+    // 提醒管理函数：按 ID 定位行，只通知受影响的行，不重置模型。
+    // 添加已存在的 ID 视为整行更新，更新不存在的 ID 视为添加，删除不存在的 ID 忽略。
+    // 删除推迟到回到事件循环后合并执行，期间 contains() 已不再包含该 ID
     void addReminder(const Reminder &reminder);
-    void updateReminder(int row, const Reminder &reminder);
-    void removeReminder(int row);
+    void updateReminder(const Reminder &reminder, Reminder::Fields fields);
+    void removeReminder(const QString &id);
+    bool contains(const QString &id) const;
     Reminder getReminder(int row) const;
 
     // JSON序列化
     void loadFromJson(const QList<Reminder> &reminders);
     QJsonArray saveToJson() const;
 
-    // 搜索功能
-    void search(const QString &text);
-
 private:
-    void updateFilteredList();
-    QVector<Reminder> getAllReminders() const;
+    void applyPendingRemovals();
 
     QVector<Reminder> m_reminders;
-    QVector<Reminder> m_filteredReminders;
-    QString m_searchText;
-    bool m_isFiltered;
+    // ID -> 行号
+    QHash<ReminderId, int> m_rows;
+    // 等待合并移除的 ID，其行仍在 m_reminders 中
+    QSet<ReminderId> m_pendingRemovals;
 };
 
 #endif // ACTIVE_REMINDERTABLEMODEL_H
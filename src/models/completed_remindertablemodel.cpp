@@ -1,12 +1,19 @@
 #include "models/completed_remindertablemodel.h"
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QMetaObject>
 #include <algorithm>
+#include <utility>
 #include "core/providers/priorityiconprovider.h"
+#include "models/remindercolumns.h"
+
+namespace {
+// 一轮事件里攒下的删除超过该数量时整体重置模型，避免逐段移除的拷贝开销
+constexpr int kResetRemovalThreshold = 64;
+}
 
 CompletedReminderTableModel::CompletedReminderTableModel(QObject *parent)
     : QAbstractTableModel(parent)
-    , m_isFiltered(false)
 {
 }
 
@@ -14,14 +21,14 @@ int CompletedReminderTableModel::rowCount(const QModelIndex &parent) const
 {
     if (parent.isValid())
         return 0;
-    return m_isFiltered ? m_filteredReminders.size() : m_reminders.size();
+    return m_reminders.size();
 }
 
 int CompletedReminderTableModel::columnCount(const QModelIndex &parent) const
 {
     if (parent.isValid())
         return 0;
-    return 4;
+    return ReminderColumns::Count;
 }
 
 QVariant CompletedReminderTableModel::data(const QModelIndex &index, int role) const
@@ -29,7 +36,7 @@ QVariant CompletedReminderTableModel::data(const QModelIndex &index, int role) c
     if (!index.isValid())
         return QVariant();
 
-    const Reminder &reminder = m_isFiltered ? m_filteredReminders[index.row()] : m_reminders[index.row()];
+    const Reminder &reminder = m_reminders[index.row()];
 
     if (role == Qt::DisplayRole || role == Qt::EditRole) {
         switch (index.column()) {
@@ -86,13 +93,7 @@ bool CompletedReminderTableModel::setData(const QModelIndex &index, const QVaria
     if (!index.isValid() || role != Qt::EditRole)
         return false;
 
-    int row = index.row();
-    if (m_isFiltered) {
-        if (row >= m_filteredReminders.size())
-            return false;
-        row = m_reminders.indexOf(m_filteredReminders[row]);
-    }
-
+    const int row = index.row();
     if (row >= m_reminders.size())
         return false;
 
@@ -122,58 +123,119 @@ Qt::ItemFlags CompletedReminderTableModel::flags(const QModelIndex &index) const
 
 void CompletedReminderTableModel::addReminder(const Reminder &reminder)
 {
-    beginInsertRows(QModelIndex(), m_reminders.size(), m_reminders.size());
+    // 同一 ID 在等待移除时又被加回，先落实移除，保持通知的先后顺序
+    if (m_pendingRemovals.contains(reminder.key())) {
+        applyPendingRemovals();
+    }
+    if (m_rows.contains(reminder.key())) {
+        updateReminder(reminder, Reminder::Field::Name | Reminder::Field::Type
+                                     | Reminder::Field::Priority | Reminder::Field::NextTrigger);
+        return;
+    }
+    const int row = m_reminders.size();
+    beginInsertRows(QModelIndex(), row, row);
     m_reminders.append(reminder);
+    m_rows.insert(reminder.key(), row);
     endInsertRows();
-    updateFilteredList();
 }
 
-void CompletedReminderTableModel::updateReminder(int row, const Reminder &reminder)
+void CompletedReminderTableModel::updateReminder(const Reminder &reminder, Reminder::Fields fields)
 {
-    if (row < 0 || row >= m_reminders.size())
+    if (m_pendingRemovals.contains(reminder.key())) {
+        applyPendingRemovals();
+    }
+    auto it = m_rows.constFind(reminder.key());
+    if (it == m_rows.constEnd()) {
+        addReminder(reminder);
         return;
-
+    }
+    const int row = it.value();
     m_reminders[row] = reminder;
-    emit dataChanged(index(row, 0), index(row, columnCount() - 1));
-    updateFilteredList();
+    int first = 0;
+    int last = 0;
+    if (ReminderColumns::changedColumns(fields, first, last)) {
+        emit dataChanged(index(row, first), index(row, last));
+    }
 }
 
-void CompletedReminderTableModel::removeReminder(int row)
+void CompletedReminderTableModel::removeReminder(const QString &id)
 {
-    if (row < 0 || row >= m_reminders.size())
+    const ReminderId key = ReminderId::fromString(id);
+    if (!m_rows.contains(key) || m_pendingRemovals.contains(key))
         return;
 
-    beginRemoveRows(QModelIndex(), row, row);
-    m_reminders.removeAt(row);
-    endRemoveRows();
-    updateFilteredList();
+    // 批量删除时管理器逐条发出通知；先攒起来，回到事件循环后一次性移除，
+    // 后续行的下标只重建一次，而不是每删一行都整体前移
+    const bool scheduled = !m_pendingRemovals.isEmpty();
+    m_pendingRemovals.insert(key);
+    if (!scheduled) {
+        QMetaObject::invokeMethod(this, [this]() { applyPendingRemovals(); }, Qt::QueuedConnection);
+    }
 }
 
-void CompletedReminderTableModel::removeReminders(const QList<QPair<int, Reminder>> &reminders)
+void CompletedReminderTableModel::applyPendingRemovals()
 {
-    if (reminders.isEmpty()) {
+    if (m_pendingRemovals.isEmpty())
         return;
+
+    QVector<int> rows;
+    rows.reserve(m_pendingRemovals.size());
+    for (const ReminderId &key : std::as_const(m_pendingRemovals)) {
+        auto it = m_rows.find(key);
+        if (it != m_rows.end()) {
+            rows.append(it.value());
+            m_rows.erase(it);
+        }
     }
+    m_pendingRemovals.clear();
+    if (rows.isEmpty())
+        return;
+    std::sort(rows.begin(), rows.end());
 
-    // 按行号从大到小排序，这样删除时不会影响其他行的索引
-    QList<int> rowsToRemove;
-    for (const auto &pair : reminders) {
-        rowsToRemove.append(pair.first);
+    if (rows.size() > kResetRemovalThreshold) {
+        // 删除较多时一次遍历压缩，整体重置
+        beginResetModel();
+        int next = 0;
+        int write = 0;
+        for (int read = 0; read < m_reminders.size(); ++read) {
+            if (next < rows.size() && rows[next] == read) {
+                ++next;
+                continue;
+            }
+            if (write != read) {
+                m_reminders[write] = std::move(m_reminders[read]);
+            }
+            ++write;
+        }
+        m_reminders.resize(write);
+        for (int i = rows.first(); i < m_reminders.size(); ++i) {
+            m_rows[m_reminders[i].key()] = i;
+        }
+        endResetModel();
+        return;
     }
-    std::sort(rowsToRemove.begin(), rowsToRemove.end(), std::greater<int>());
 
-    // 一次性通知视图将要删除多行
-    beginRemoveRows(QModelIndex(), rowsToRemove.last(), rowsToRemove.first());
-    
-    // 从大到小删除，这样不会影响前面的索引
-    for (int row : rowsToRemove) {
-        if (row >= 0 && row < m_reminders.size()) {
-            m_reminders.removeAt(row);
+    // 从后往前按连续区间移除，保持行序稳定（选中状态随行移动）
+    int last = rows.size() - 1;
+    while (last >= 0) {
+        int first = last;
+        while (first > 0 && rows[first - 1] == rows[first] - 1) {
+            --first;
         }
+        beginRemoveRows(QModelIndex(), rows[first], rows[last]);
+        m_reminders.remove(rows[first], rows[last] - rows[first] + 1);
+        endRemoveRows();
+        last = first - 1;
     }
-    
-    endRemoveRows();
-    updateFilteredList();
+    for (int i = rows.first(); i < m_reminders.size(); ++i) {
+        m_rows[m_reminders[i].key()] = i;
+    }
+}
+
+bool CompletedReminderTableModel::contains(const QString &id) const
+{
+    const ReminderId key = ReminderId::fromString(id);
+    return m_rows.contains(key) && !m_pendingRemovals.contains(key);
 }
 
 Reminder CompletedReminderTableModel::getReminder(int row) const
@@ -183,15 +245,16 @@ Reminder CompletedReminderTableModel::getReminder(int row) const
     return m_reminders[row];
 }
 
-QVector<Reminder> CompletedReminderTableModel::getAllReminders() const
-{
-    return m_reminders;
-}
-
 void CompletedReminderTableModel::loadFromJson(const QList<Reminder> &reminders)
 {
     beginResetModel();
     m_reminders = reminders;
+    m_rows.clear();
+    m_pendingRemovals.clear();
+    m_rows.reserve(m_reminders.size());
+    for (int i = 0; i < m_reminders.size(); ++i) {
+        m_rows.insert(m_reminders[i].key(), i);
+    }
     endResetModel();
 }
 
@@ -203,28 +266,3 @@ QJsonArray CompletedReminderTableModel::saveToJson() const
     }
     return array;
 }
-
-
-void CompletedReminderTableModel::search(const QString &text)
-{
-    m_searchText = text;
-    updateFilteredList();
-}
-
-void CompletedReminderTableModel::updateFilteredList()
-{
-    if (m_searchText.isEmpty()) {
-        m_isFiltered = false;
-        emit layoutChanged();
-        return;
-    }
-
-    m_filteredReminders.clear();
-    for (const Reminder &reminder : m_reminders) {
-        if (reminder.name().contains(m_searchText, Qt::CaseInsensitive)) {
-            m_filteredReminders.append(reminder);
-        }
-    }
-    m_isFiltered = true;
-    emit layoutChanged();
-}
@@ -0,0 +1,32 @@
+#ifndef REMINDERCOLUMNS_H
+#define REMINDERCOLUMNS_H
+
+#include "core/reminders/reminder.h"
+
+// 进行中与已完成列表共用的列布局：名称、类型、优先级、时间
+namespace ReminderColumns {
+
+constexpr int Count = 4;
+
+// 把变化的字段换算成需要重绘的列区间；没有可见列变化时返回 false
+inline bool changedColumns(Reminder::Fields fields, int &first, int &last)
+{
+    static const Reminder::Field columns[Count] = {
+        Reminder::Field::Name, Reminder::Field::Type, Reminder::Field::Priority, Reminder::Field::NextTrigger
+    };
+    first = -1;
+    last = -1;
+    for (int column = 0; column < Count; ++column) {
+        if (fields.testFlag(columns[column])) {
+            if (first < 0) {
+                first = column;
+            }
+            last = column;
+        }
+    }
+    return first >= 0;
+}
+
+}
+
+#endif // REMINDERCOLUMNS_H
@@ -1,7 +1,6 @@
 #include "ui/widgets/active_reminderedit.h"
 #include "ui_reminderedit.h"
 #include <QMessageBox>
-#include <QUuid>
 #include <QDateTime>
 #include <QFile>
 #include <QPushButton>
@@ -11,6 +10,7 @@
 #include <QList>
 #include "core/logging/logger.h"
 #include "core/calendar/workdaycalendar.h"
+#include "core/time/clock.h"
 
 namespace {
 constexpr auto kDateTimeFormat = "yyyy-MM-dd HH:mm";
@@ -60,7 +60,7 @@ void ActiveReminderEdit::prepareNewReminder()
     setWindowTitle(tr("新增提醒"));
 
     ui->nameEdit->clear();
-    const QDateTime now = toMinutePrecision(QDateTime::currentDateTime());
+    const QDateTime now = toMinutePrecision(Clock::instance().now());
     ui->dateTimeEdit->setDateTime(now);
     ui->timeEdit->setTime(now.time());
     ui->typeCombo->setCurrentIndex(0);
@@ -68,7 +68,7 @@ void ActiveReminderEdit::prepareNewReminder()
     ui->nameEdit->setFocus();
 
     m_reminder = Reminder();
-    m_reminder.setId(QUuid::createUuid().toString(QUuid::WithoutBraces));
+    m_reminder.setKey(ReminderId::createRandom());
     m_reminder.setType(Reminder::Type::Once);
     m_reminder.setNextTrigger(now);
     m_reminder.setPriority(Reminder::Priority::Low);
@@ -200,7 +200,7 @@ void ActiveReminderEdit::onDaysChanged()
 
 QDateTime ActiveReminderEdit::calculateNextTrigger() const
 {
-    QDateTime now = QDateTime::currentDateTime();
+    QDateTime now = Clock::instance().now();
     QDateTime nextTrigger;
     Reminder::Type type = static_cast<Reminder::Type>(ui->typeCombo->currentIndex());
 
@@ -264,7 +264,7 @@ bool ActiveReminderEdit::validateInput() const
     // 检查一次性提醒的时间是否有效
     if (ui->typeCombo->currentIndex() == 0) { // 一次性提醒
         const QDateTime selectedTime = toMinutePrecision(ui->dateTimeEdit->dateTime());
-        const QDateTime currentTime = toMinutePrecision(QDateTime::currentDateTime());
+        const QDateTime currentTime = toMinutePrecision(Clock::instance().now());
         
         if (selectedTime <= currentTime) {
             QMessageBox::warning(const_cast<ActiveReminderEdit*>(this),
@@ -39,7 +39,21 @@ ActiveReminderList::~ActiveReminderList()
 void ActiveReminderList::setReminderManager(ReminderManager *manager)
 {
     LOG_INFO("设置提醒管理器");
+    if (reminderManager) {
+        disconnect(reminderManager, nullptr, this, nullptr);
+    }
     reminderManager = manager;
+    if (!reminderManager) {
+        return;
+    }
+    // 无论修改来自界面、导入还是调度器，列表都通过这些信号同步；
+    // 排队执行，避免在列表自身的事件处理过程中改动模型
+    connect(reminderManager, &ReminderManager::reminderAdded,
+            this, &ActiveReminderList::onReminderAdded, Qt::QueuedConnection);
+    connect(reminderManager, &ReminderManager::reminderUpdated,
+            this, &ActiveReminderList::onReminderUpdated, Qt::QueuedConnection);
+    connect(reminderManager, &ReminderManager::reminderRemoved,
+            this, &ActiveReminderList::onReminderRemoved, Qt::QueuedConnection);
 }
 
 void ActiveReminderList::setupConnections()
@@ -55,7 +69,8 @@ void ActiveReminderList::setupModel()
     LOG_INFO("设置数据模型");
     // 设置代理模型
     proxyModel->setSourceModel(model);
-    proxyModel->setFilterKeyColumn(-1); // 设置为-1表示搜索所有列
+    // 搜索只匹配名称，与改用代理模型过滤之前的行为一致
+    proxyModel->setFilterKeyColumn(Name);
     proxyModel->setFilterCaseSensitivity(Qt::CaseInsensitive); // 不区分大小写
     proxyModel->setDynamicSortFilter(true); // 启用动态过滤
 
@@ -105,7 +120,6 @@ void ActiveReminderList::addNewReminder()
         if (!reminder.name().isEmpty()) {
             if (reminderManager) {
                 reminderManager->addReminder(reminder);
-                model->addReminder(reminder);
                 LOG_INFO(QString("新提醒添加成功: 名称='%1', ID='%2'")
                         .arg(reminder.name())
                         .arg(reminder.id()));
@@ -118,67 +132,6 @@ void ActiveReminderList::addNewReminder()
     }
 }
 
-void ActiveReminderList::addReminderToModel(const Reminder &reminder)
-{
-    LOG_INFO(QString("添加提醒到模型: 名称='%1'").arg(reminder.name()));
-    model->addReminder(reminder);
-    LOG_INFO("提醒已添加到模型");
-}
-
-void ActiveReminderList::updateReminderInModel(const Reminder &reminder)
-{
-    LOG_INFO(QString("更新提醒: 名称='%1'").arg(reminder.name()));
-    
-    // 保存当前选择的ID
-    QString currentId;
-    QModelIndex currentIndex = ui->tableView->currentIndex();
-    if (currentIndex.isValid()) {
-        QModelIndex sourceIndex = proxyModel->mapToSource(currentIndex);
-        if (sourceIndex.isValid()) {
-            currentId = model->getReminder(sourceIndex.row()).id();
-        }
-    }
-    
-    // 更新模型前先暂停选择模型的信号
-    ui->tableView->selectionModel()->blockSignals(true);
-    
-    // 更新模型
-    for (int i = 0; i < model->rowCount(); ++i) {
-        Reminder existingReminder = model->getReminder(i);
-        if (existingReminder.id() == reminder.id()) {
-            // 在更新数据之前先清除选择
-            ui->tableView->clearSelection();
-            
-            model->updateReminder(i, reminder);
-            LOG_INFO(QString("提醒更新成功: 名称='%1', 类型=%2")
-                    .arg(reminder.name())
-                    .arg(static_cast<int>(reminder.type())));
-            
-            // 发出数据改变信号，而不是重置整个模型
-            QModelIndex topLeft = model->index(i, 0);
-            QModelIndex bottomRight = model->index(i, model->columnCount() - 1);
-            emit model->dataChanged(topLeft, bottomRight);
-            
-            // 恢复选择
-            if (!currentId.isEmpty()) {
-                QModelIndex newSourceIndex = model->index(i, 0);
-                QModelIndex newProxyIndex = proxyModel->mapFromSource(newSourceIndex);
-                if (newProxyIndex.isValid()) {
-                    ui->tableView->setCurrentIndex(newProxyIndex);
-                    ui->tableView->selectionModel()->select(
-                        newProxyIndex,
-                        QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows
-                    );
-                }
-            }
-            break;
-        }
-    }
-    
-    // 恢复选择模型的信号
-    ui->tableView->selectionModel()->blockSignals(false);
-}
-
 void ActiveReminderList::editReminder(const QModelIndex &index)
 {
     QModelIndex sourceIndex = proxyModel->mapToSource(index);
@@ -188,7 +141,6 @@ void ActiveReminderList::editReminder(const QModelIndex &index)
     editDialog->prepareEditReminder(reminder);
     if (editDialog->exec() == QDialog::Accepted) {
         Reminder updatedReminder = editDialog->getReminder();
-        updateReminderInModel(updatedReminder);
         if (reminderManager) {
             reminderManager->updateReminder(updatedReminder);
             LOG_INFO(QString("提醒管理器更新成功: 名称='%1'").arg(updatedReminder.name()));
@@ -212,7 +164,6 @@ void ActiveReminderList::deleteReminder(const QModelIndex &index)
     );
 
     if (reply == QMessageBox::Yes) {
-        model->removeReminder(sourceIndex.row());
         if (reminderManager) {
             reminderManager->deleteReminder(reminder);
             LOG_INFO(QString("提醒删除成功: 名称='%1'").arg(reminder.name()));
@@ -226,13 +177,35 @@ void ActiveReminderList::deleteReminder(const QModelIndex &index)
 void ActiveReminderList::refreshList()
 {
     LOG_INFO(QString("刷新提醒列表，搜索文本: '%1'").arg(m_searchText));
-    model->search(m_searchText);
+    proxyModel->setFilterFixedString(m_searchText);
 }
 
 void ActiveReminderList::searchReminders(const QString &text)
 {
     LOG_INFO(QString("搜索提醒: '%1'").arg(text));
-    model->search(text);
+    proxyModel->setFilterFixedString(text);
+}
+
+void ActiveReminderList::onReminderAdded(const Reminder &reminder)
+{
+    if (!reminder.completed()) {
+        model->addReminder(reminder);
+    }
+}
+
+void ActiveReminderList::onReminderUpdated(const Reminder &reminder, Reminder::Fields fields)
+{
+    // 完成后的提醒移到已完成列表；重新启用的提醒回到这里
+    if (reminder.completed()) {
+        model->removeReminder(reminder.id());
+        return;
+    }
+    model->updateReminder(reminder, fields);
+}
+
+void ActiveReminderList::onReminderRemoved(const QString &id)
+{
+    model->removeReminder(id);
 }
 
 
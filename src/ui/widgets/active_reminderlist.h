@@ -33,6 +33,12 @@ public slots:
     void onDeleteClicked();
     void onSearchTextChanged(const QString &text);
 
+private slots:
+    // 调度器的细粒度变更通知，只改动受影响的行
+    void onReminderAdded(const Reminder &reminder);
+    void onReminderUpdated(const Reminder &reminder, Reminder::Fields fields);
+    void onReminderRemoved(const QString &id);
+
 private:
     void setupConnections();
     void setupModel();
@@ -42,8 +48,6 @@ private:
     void deleteReminder(const QModelIndex &index);
     void refreshList();
     void searchReminders(const QString &text);
-    void addReminderToModel(const Reminder &reminder);
-    void updateReminderInModel(const Reminder &reminder);
 
     Ui::ActiveReminderList *ui;
     ReminderManager *reminderManager;
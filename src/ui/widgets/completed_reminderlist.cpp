@@ -37,7 +37,20 @@ CompletedReminderList::~CompletedReminderList()
 void CompletedReminderList::setReminderManager(ReminderManager *manager)
 {
     LOG_INFO("设置提醒管理器");
+    if (reminderManager) {
+        disconnect(reminderManager, nullptr, this, nullptr);
+    }
     reminderManager = manager;
+    if (!reminderManager) {
+        return;
+    }
+    // 排队执行，避免在列表自身的事件处理过程中改动模型
+    connect(reminderManager, &ReminderManager::reminderAdded,
+            this, &CompletedReminderList::onReminderAdded, Qt::QueuedConnection);
+    connect(reminderManager, &ReminderManager::reminderUpdated,
+            this, &CompletedReminderList::onReminderUpdated, Qt::QueuedConnection);
+    connect(reminderManager, &ReminderManager::reminderRemoved,
+            this, &CompletedReminderList::onReminderRemoved, Qt::QueuedConnection);
 }
 
 void CompletedReminderList::setupConnections()
@@ -53,7 +66,8 @@ void CompletedReminderList::setupModel()
     LOG_INFO("设置数据模型");
     // 设置代理模型
     proxyModel->setSourceModel(model);
-    proxyModel->setFilterKeyColumn(-1); // 设置为-1表示搜索所有列
+    // 搜索只匹配名称，与改用代理模型过滤之前的行为一致
+    proxyModel->setFilterKeyColumn(Name);
     proxyModel->setFilterCaseSensitivity(Qt::CaseInsensitive); // 不区分大小写
 
     // 设置表格视图
@@ -93,7 +107,6 @@ void CompletedReminderList::deleteReminder(const QModelIndex &index)
     );
 
     if (reply == QMessageBox::Yes) {
-        model->removeReminder(sourceIndex.row());
         if (reminderManager) {
             reminderManager->deleteReminder(reminder);
             LOG_INFO(QString("提醒删除成功: 名称='%1'").arg(reminder.name()));
@@ -107,13 +120,34 @@ void CompletedReminderList::deleteReminder(const QModelIndex &index)
 void CompletedReminderList::refreshList()
 {
     LOG_INFO(QString("刷新提醒列表，搜索文本: '%1'").arg(m_searchText));
-    model->search(m_searchText);
+    proxyModel->setFilterFixedString(m_searchText);
 }
 
 void CompletedReminderList::searchReminders(const QString &text)
 {
     LOG_INFO(QString("搜索提醒: '%1'").arg(text));
-    model->search(text);
+    proxyModel->setFilterFixedString(text);
+}
+
+void CompletedReminderList::onReminderAdded(const Reminder &reminder)
+{
+    if (reminder.completed()) {
+        model->addReminder(reminder);
+    }
+}
+
+void CompletedReminderList::onReminderUpdated(const Reminder &reminder, Reminder::Fields fields)
+{
+    if (!reminder.completed()) {
+        model->removeReminder(reminder.id());
+        return;
+    }
+    model->updateReminder(reminder, fields);
+}
+
+void CompletedReminderList::onReminderRemoved(const QString &id)
+{
+    model->removeReminder(id);
 }
 
 void CompletedReminderList::onDeleteClicked()
@@ -131,27 +165,22 @@ void CompletedReminderList::onDeleteClicked()
     );
 
     if (reply == QMessageBox::Yes) {
-        // 先收集所有要删除的提醒
-        QList<QPair<int, Reminder>> toDelete;
+        // 先收集所有要删除的提醒 ID
+        QStringList ids;
+        ids.reserve(selectedIndexes.size());
         for (const QModelIndex &index : selectedIndexes) {
             QModelIndex sourceIndex = proxyModel->mapToSource(index);
             if (sourceIndex.isValid()) {
-                Reminder reminder = model->getReminder(sourceIndex.row());
-                toDelete.append({sourceIndex.row(), reminder});
+                ids.append(model->getReminder(sourceIndex.row()).id());
             }
         }
 
         // 在删除前清空选区，避免模型更新过程中访问无效索引
         ui->tableView->clearSelection();
 
-        // 执行批量删除
-        model->removeReminders(toDelete);
-        
-        // 从提醒管理器中删除
+        // 从提醒管理器中批量删除，只写一次数据库；列表随 reminderRemoved 通知更新
         if (reminderManager) {
-            for (const auto &pair : toDelete) {
-                reminderManager->deleteReminder(pair.second);
-            }
+            reminderManager->deleteReminders(ids);
         }
     }
 }
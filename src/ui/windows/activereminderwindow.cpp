@@ -3,29 +3,22 @@
 #include <QPushButton>
 #include <QTableView>
 #include <QModelIndex>
-#include <QShowEvent>
 
 ActiveReminderWindow::ActiveReminderWindow(QWidget *parent)
     : QWidget(parent)
     , ui(new Ui::ActiveReminderWindow)
     , reminderManager(nullptr)
+    , loadedGeneration(0)
 {
     ui->setupUi(this);
 
     if (ui->activeList) {
         connect(ui->activeList->addButton(), &QPushButton::clicked,
-                this, [this]() { ui->activeList->onAddClicked(); refreshReminders(); });
+                this, [this]() { ui->activeList->onAddClicked(); });
         connect(ui->activeList->deleteButton(), &QPushButton::clicked,
-                this, [this]() { ui->activeList->onDeleteClicked(); refreshReminders(); });
+                this, [this]() { ui->activeList->onDeleteClicked(); });
         connect(ui->activeList->tableView(), &QTableView::doubleClicked,
-                this, [this](const QModelIndex &) {
-                    ui->activeList->onEditClicked();
-                    // 刷新列表需要在事件处理完成后再执行，
-                    // 否则在双击事件链中重置模型可能导致崩溃
-                    QMetaObject::invokeMethod(this,
-                                            &ActiveReminderWindow::refreshReminders,
-                                            Qt::QueuedConnection);
-                });
+                this, [this](const QModelIndex &) { ui->activeList->onEditClicked(); });
     }
 }
 
@@ -37,11 +30,14 @@ ActiveReminderWindow::~ActiveReminderWindow()
 void ActiveReminderWindow::setReminderManager(ReminderManager *manager)
 {
     reminderManager = manager;
+    loadedGeneration = 0;
     if (ui->activeList)
         ui->activeList->setReminderManager(manager);
     if (reminderManager) {
-        connect(reminderManager, &ReminderManager::reminderTriggered,
-                this, &ActiveReminderWindow::refreshReminders, Qt::UniqueConnection);
+        // 单条变更由列表控件按行同步；批量变更时改为从快照整体重新加载
+        connect(reminderManager, &ReminderManager::remindersReset,
+                this, &ActiveReminderWindow::refreshReminders,
+                static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::UniqueConnection));
     }
     refreshReminders();
 }
@@ -50,17 +46,14 @@ void ActiveReminderWindow::refreshReminders()
 {
     if (!reminderManager)
         return;
+    const ReminderSnapshotPtr current = reminderManager->snapshot();
+    if (current->generation == loadedGeneration)
+        return;
+    loadedGeneration = current->generation;
     QList<Reminder> filtered;
-    const QVector<Reminder> all = reminderManager->getReminders();
-    for (const Reminder &r : all) {
+    current->forEach([&filtered](const Reminder &r) {
         if (!r.completed())
             filtered.append(r);
-    }
+    });
     ui->activeList->loadReminders(filtered);
 }
-
-void ActiveReminderWindow::showEvent(QShowEvent *event)
-{
-    QWidget::showEvent(event);
-    refreshReminders();
-}
@@ -3,18 +3,18 @@
 #include <QPushButton>
 #include <QTableView>
 #include <QModelIndex>
-#include <QShowEvent>
 
 CompletedReminderWindow::CompletedReminderWindow(QWidget *parent)
     : QWidget(parent)
     , ui(new Ui::CompletedReminderWindow)
     , reminderManager(nullptr)
+    , loadedGeneration(0)
 {
     ui->setupUi(this);
 
     if (ui->completedList) {
         connect(ui->completedList->deleteButton(), &QPushButton::clicked,
-                this, [this]() { ui->completedList->onDeleteClicked(); refreshReminders(); });
+                this, [this]() { ui->completedList->onDeleteClicked(); });
     }
 }
 
@@ -26,11 +26,14 @@ CompletedReminderWindow::~CompletedReminderWindow()
 void CompletedReminderWindow::setReminderManager(ReminderManager *manager)
 {
     reminderManager = manager;
+    loadedGeneration = 0;
     if (ui->completedList)
         ui->completedList->setReminderManager(manager);
     if (reminderManager) {
-        connect(reminderManager, &ReminderManager::reminderTriggered,
-                this, &CompletedReminderWindow::refreshReminders, Qt::UniqueConnection);
+        // 单条变更由列表控件按行同步；批量变更时改为从快照整体重新加载
+        connect(reminderManager, &ReminderManager::remindersReset,
+                this, &CompletedReminderWindow::refreshReminders,
+                static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::UniqueConnection));
     }
     refreshReminders();
 }
@@ -39,17 +42,14 @@ void CompletedReminderWindow::refreshReminders()
 {
     if (!reminderManager)
         return;
+    const ReminderSnapshotPtr current = reminderManager->snapshot();
+    if (current->generation == loadedGeneration)
+        return;
+    loadedGeneration = current->generation;
     QList<Reminder> filtered;
-    const QVector<Reminder> all = reminderManager->getReminders();
-    for (const Reminder &r : all) {
+    current->forEach([&filtered](const Reminder &r) {
         if (r.completed())
             filtered.append(r);
-    }
+    });
     ui->completedList->loadReminders(filtered);
 }
-
-void CompletedReminderWindow::showEvent(QShowEvent *event)
-{
-    QWidget::showEvent(event);
-    refreshReminders();
-}
@@ -2,7 +2,6 @@
 #define COMPLETEDREMINDERWINDOW_H
 
 #include <QWidget>
-#include <QShowEvent>
 #include "ui/widgets/completed_reminderlist.h"
 
 namespace Ui {
@@ -22,12 +21,11 @@ public:
 private slots:
     void refreshReminders();
 
-protected:
-    void showEvent(QShowEvent *event) override;
-
 private:
     Ui::CompletedReminderWindow *ui;
     ReminderManager *reminderManager;
+    // 上次整体载入列表时的快照代号，未变化时跳过刷新；之后的单条变更由列表控件按行同步
+    quint64 loadedGeneration;
 };
 
 #endif // COMPLETEDREMINDERWINDOW_H
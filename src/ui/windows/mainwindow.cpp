@@ -10,6 +10,7 @@
 #include <QCloseEvent>
 #include "core/config/configmanager.h"
 #include "core/logging/logger.h"
+#include "core/reminders/triggerstats.h"
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -28,10 +29,12 @@ MainWindow::MainWindow(QWidget *parent)
 
     setupUI();
 
-    // 创建提醒管理器(运行于工作线程)
+    // 创建提醒管理器(运行于独立调度线程，触发信号以排队方式送达界面)
     reminderManager = new ReminderManager();
-    connect(reminderManager, &ReminderManager::reminderTriggered,
-            this, &MainWindow::displayNotification);
+    connect(reminderManager, &ReminderManager::remindersTriggered,
+            this, &MainWindow::displayNotifications);
+    connect(reminderManager, &ReminderManager::reminderMissed,
+            this, &MainWindow::displayMissedNotification);
 
     // 连接提醒列表和提醒管理器
     activeWindow->setReminderManager(reminderManager);
@@ -59,7 +62,34 @@ MainWindow::MainWindow(QWidget *parent)
     }
 }
 
-void MainWindow::displayNotification(const Reminder &reminder)
+void MainWindow::displayNotifications(const QVector<Reminder> &reminders, qint64 dispatchedAtUs)
+{
+    // 默认每个提醒各弹一个窗口；设置了上限时只弹出前几条，其余合并为一条汇总
+    const int maxPopups = ConfigManager::instance().maxPopups();
+    const int shown = maxPopups > 0 && reminders.size() > maxPopups ? maxPopups - 1 : reminders.size();
+    Reminder::Priority highest = Reminder::Priority::Low;
+    for (int i = 0; i < reminders.size(); ++i) {
+        const Reminder &reminder = reminders.at(i);
+        if (i < shown) {
+            showPopup(reminder.name(), reminder.priority());
+        } else if (static_cast<int>(reminder.priority()) > static_cast<int>(highest)) {
+            highest = reminder.priority();
+        }
+    }
+    if (shown < reminders.size()) {
+        showPopup(tr("另有 %1 个提醒同时到期").arg(reminders.size() - shown), highest);
+    }
+
+    // 调度线程发出信号到弹窗显示完成的耗时
+    TriggerStats::instance().recordDisplayDelay(TriggerStats::monotonicMicros() - dispatchedAtUs);
+}
+
+void MainWindow::displayMissedNotification(const Reminder &reminder, int missedCount)
+{
+    showPopup(tr("%1（错过 %2 次）").arg(reminder.name()).arg(missedCount), reminder.priority());
+}
+
+void MainWindow::showPopup(const QString &title, Reminder::Priority priority)
 {
     QScreen *trayScreen = nullptr;
     if (trayIcon) {
@@ -72,8 +102,8 @@ void MainWindow::displayNotification(const Reminder &reminder)
         trayScreen = QGuiApplication::primaryScreen();
     }
 
-    NotificationPopup *popup = new NotificationPopup(reminder.name(),
-                                                     reminder.priority(),
+    NotificationPopup *popup = new NotificationPopup(title,
+                                                     priority,
                                                      soundEnabled,
                                                      this,
                                                      trayScreen);
@@ -190,7 +220,7 @@ void MainWindow::onPauseReminders()
         reminderManager->resumeAll();
         trayIcon->setIcon(QIcon(":/img/tray_icon.png"));
     }
-    ConfigManager::instance().setPaused(isPaused);
+    // pauseAll/resumeAll 已写入配置，这里不再重复写
     LOG_INFO(QString("勿扰模式已%1").arg(isPaused ? "开启" : "关闭"));
 }
 
@@ -29,13 +29,15 @@ private slots:
     void onToggleAutoStart();
     void onToggleSound();
     void onQuit();
-    void displayNotification(const Reminder &reminder);
+    void displayNotifications(const QVector<Reminder> &reminders, qint64 dispatchedAtUs);
+    void displayMissedNotification(const Reminder &reminder, int missedCount);
 
 private:
     void setupUI();
     void setupConnections();
     void createTrayIcon();
     void createActions();
+    void showPopup(const QString &title, Reminder::Priority priority);
 
     Ui::MainWindow *ui;
     ActiveReminderWindow *activeWindow;